@@ -0,0 +1,539 @@
+/*********************************************************************
+** Program name: bench.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Times the board and the rules on maps from the 7x7 default
+** size up to 10^7 spaces, and writes the results as JSON so that runs on
+** different commits can be compared. For each map size it times reading the
+** map from a file, building the board from it, moving the player, printing
+** the board, deleting the board, and whole headless game turns with random
+** actions through GameState. On maps a GameBatch can play, it also times
+** batches of games stepped under the standard and hardcore rules, both fixed
+** at compile time and held in RuntimeRules, to show what fixing them saves.
+**
+** Each benchmark is first warmed up, which also picks how many operations
+** are timed at once so that one repetition takes at least MIN_SECONDS; it is
+** then repeated -reps times, and the minimum, median, mean and standard
+** deviation of the time per operation are reported. Maps are made by
+** LevelGenerator from the seed, so every run times the same maps. The bytes
+** each board holds, as counted by MemoryStats, are reported with the times.
+**
+** Usage: bench [-out file] [-max cells] [-reps n] [-seed n] [-label text]
+*********************************************************************/
+
+#include "board.hpp"
+#include "gameBatch.hpp"
+#include "gameState.hpp"
+#include "levelGenerator.hpp"
+#include "memoryStats.hpp"
+#include "player.hpp"
+#include "space.hpp"
+#include "symbols.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  const char MAP_FILENAME[] = "bench.map.txt"; // written for reading back
+  const double MIN_SECONDS = 0.05; // shortest repetition timed
+
+  // Map sizes timed, as rows x cols: the default map's size, then each power
+  // of ten from 10^3 to 10^7 spaces
+  const int SIZES[][2] = {
+    { 7, 7 }, { 25, 40 }, { 100, 100 }, { 250, 400 }, { 1000, 1000 },
+    { 2500, 4000 } };
+  const int SIZE_COUNT = sizeof(SIZES) / sizeof(SIZES[0]);
+
+  const GameState::Action ACTIONS[] = {
+    GameState::MOVE_UP, GameState::MOVE_DOWN, GameState::MOVE_LEFT,
+    GameState::MOVE_RIGHT, GameState::INSPECT };
+  const int ACTION_COUNT = sizeof(ACTIONS) / sizeof(ACTIONS[0]);
+
+  const int BATCH_GAMES = 1024; // games stepped at once by the batch benchmarks
+  const int BATCH_ROUNDS = 64; // sets of random actions cycled through
+
+  // Times count operations and returns the seconds spent on them; anything
+  // done only to set up the operations is left out of the time
+  typedef std::function<double(long count)> Run;
+
+  // The times of one benchmark on one map size
+  struct Result
+  {
+    std::string name;
+    int rows;
+    int cols;
+    bool perSpace; // whether each operation works on every space of the map
+    long count; // operations per repetition
+    std::vector<double> samples; // nanoseconds per operation, in order
+    double min;
+    double median;
+    double mean;
+    double stddev;
+  };
+
+  // The memory held by the board of one map size
+  struct Footprint
+  {
+    int rows;
+    int cols;
+    long long bytes; // spaces and map string
+  };
+
+  double secondsSince(std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  }
+
+  // Warms run up, doubling the operations until they take MIN_SECONDS, then
+  // times reps repetitions of that many operations
+  Result measure(const std::string& name, int rows, int cols, const Run& run,
+                 int reps, bool perSpace)
+  {
+    Result result;
+    result.name = name;
+    result.rows = rows;
+    result.cols = cols;
+    result.perSpace = perSpace;
+    result.count = 1;
+    while (run(result.count) < MIN_SECONDS)
+    {
+      result.count *= 2;
+    }
+
+    for (int i = 0; i < reps; i++)
+    {
+      result.samples.push_back(run(result.count) * 1e9 / result.count);
+    }
+
+    std::vector<double> sorted = result.samples;
+    std::sort(sorted.begin(), sorted.end());
+    int middle = reps / 2;
+    result.min = sorted.front();
+    result.median = reps % 2 == 1 ? sorted[middle] :
+                    (sorted[middle - 1] + sorted[middle]) / 2;
+
+    double sum = 0;
+    for (int i = 0; i < reps; i++)
+    {
+      sum += sorted[i];
+    }
+    result.mean = sum / reps;
+
+    double squares = 0;
+    for (int i = 0; i < reps; i++)
+    {
+      squares += (sorted[i] - result.mean) * (sorted[i] - result.mean);
+    }
+    result.stddev = reps > 1 ? std::sqrt(squares / (reps - 1)) : 0;
+    return result;
+  }
+
+  // Returns the bytes held by all boards: their spaces and map strings
+  long long boardBytes()
+  {
+    long long bytes = 0;
+    for (int i = MemoryStats::WALL_SPACES; i <= MemoryStats::MAPS; i++)
+    {
+      bytes += MemoryStats::getBytes(static_cast<MemoryStats::Category>(i));
+    }
+    return bytes;
+  }
+
+  // Writes map to filename as Board::readMap reads it, one row per line
+  bool writeMap(const std::string& filename, const std::string& map, int rows,
+                int cols)
+  {
+    std::ofstream out(filename.c_str(), std::ios::out | std::ios::trunc);
+    for (int i = 0; i < rows; i++)
+    {
+      out.write(map.data() + static_cast<std::size_t>(i) * cols, cols);
+      out << "\n";
+    }
+    return static_cast<bool>(out);
+  }
+
+  // Puts the player on the first space with an open space to its right, so
+  // that a map whose start is walled in can still be played; returns false if
+  // there is no such space
+  bool findOpening(Board& board, const std::string& map)
+  {
+    int cols = board.getCols();
+    for (std::size_t cell = 0; cell + 1 < map.length(); cell++)
+    {
+      if (map[cell] != WALL && map[cell + 1] != WALL &&
+          static_cast<int>(cell % cols) + 1 < cols)
+      {
+        board.placePlayer(board.getSpace(cell / cols, cell % cols));
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Times steps of a batch of BATCH_GAMES games on map under rules, with
+  // random actions; does nothing if map cannot be played in a batch
+  template <typename Rules>
+  void benchBatch(const std::string& name, const std::string& map, int rows,
+                  int cols, unsigned long long seed, int reps,
+                  const Rules& rules, std::vector<Result>& results)
+  {
+    GameBatch<Rules> batch(map, rows, cols, BATCH_GAMES, rules);
+    if (!batch.isValid())
+    {
+      return;
+    }
+
+    std::mt19937_64 random(seed);
+    std::vector<std::vector<std::uint8_t> > actions(BATCH_ROUNDS);
+    for (int i = 0; i < BATCH_ROUNDS; i++)
+    {
+      for (int j = 0; j < BATCH_GAMES; j++)
+      {
+        actions[i].push_back(random() % GameBatch<Rules>::ACTIONS);
+      }
+    }
+
+    results.push_back(measure(name, rows, cols, [&](long count)
+    {
+      std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+      for (long i = 0; i < count; i++)
+      {
+        batch.step(actions[i % BATCH_ROUNDS]);
+      }
+      return secondsSince(start);
+    }, reps, false));
+  }
+
+  // Times every benchmark on a rows x cols map made from seed and adds the
+  // results; returns false if the map could not be written
+  bool benchSize(int rows, int cols, unsigned long long seed, int reps,
+                 std::vector<Result>& results, Footprint& footprint)
+  {
+    LevelGenerator generator(rows, cols);
+    std::string map = generator.generate(seed);
+    if (!writeMap(MAP_FILENAME, map, rows, cols))
+    {
+      return false;
+    }
+
+    results.push_back(measure("readMap", rows, cols, [&](long count)
+    {
+      std::string text;
+      int readRows;
+      int readCols;
+      std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+      for (long i = 0; i < count; i++)
+      {
+        Board::loadMap(MAP_FILENAME, text, readRows, readCols);
+      }
+      return secondsSince(start);
+    }, reps, true));
+    std::remove(MAP_FILENAME);
+
+    results.push_back(measure("build", rows, cols, [&](long count)
+    {
+      double seconds = 0;
+      for (long i = 0; i < count; i++)
+      {
+        std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+        Board* board = new Board(map, rows, cols);
+        seconds += secondsSince(start);
+        delete board;
+      }
+      return seconds;
+    }, reps, true));
+
+    results.push_back(measure("teardown", rows, cols, [&](long count)
+    {
+      double seconds = 0;
+      for (long i = 0; i < count; i++)
+      {
+        Board* board = new Board(map, rows, cols);
+        std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+        delete board;
+        seconds += secondsSince(start);
+      }
+      return seconds;
+    }, reps, true));
+
+    long long before = boardBytes();
+    Board board(map, rows, cols);
+    footprint.rows = rows;
+    footprint.cols = cols;
+    footprint.bytes = boardBytes() - before;
+    if (findOpening(board, map))
+    {
+      results.push_back(measure("playerMove", rows, cols, [&](long count)
+      {
+        std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+        for (long i = 0; i < count; i++)
+        {
+          board.playerMove(i % 2 == 0 ? 'D' : 'A');
+        }
+        return secondsSince(start);
+      }, reps, false));
+    }
+
+    results.push_back(measure("print", rows, cols, [&](long count)
+    {
+      std::ostringstream out;
+      std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+      for (long i = 0; i < count; i++)
+      {
+        out.str("");
+        board.print(out);
+      }
+      return secondsSince(start);
+    }, reps, true));
+
+    Board* stateBoard = new Board(map, rows, cols);
+    findOpening(*stateBoard, map);
+    GameState state(stateBoard, false);
+    std::mt19937_64 random(seed);
+    results.push_back(measure("gameTurn", rows, cols, [&](long count)
+    {
+      std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+      for (long i = 0; i < count; i++)
+      {
+        GameState::Action action = ACTIONS[random() % ACTION_COUNT];
+        if (state.getOffer() != Space::NO_OFFER)
+        {
+          action = random() % 2 == 0 ? GameState::ACCEPT : GameState::DECLINE;
+        }
+        state.step(action);
+        if (state.getPlayer()->getState() != Player::PLAYING)
+        {
+          state.reset(); // part of the turn that ends the game
+        }
+      }
+      return secondsSince(start);
+    }, reps, false));
+
+    benchBatch("batchStandard", map, rows, cols, seed, reps, StandardRules(),
+               results);
+    benchBatch("batchStandardRt", map, rows, cols, seed, reps,
+               RuntimeRules(StandardRules()), results);
+    benchBatch("batchHardcore", map, rows, cols, seed, reps, HardcoreRules(),
+               results);
+    benchBatch("batchHardcoreRt", map, rows, cols, seed, reps,
+               RuntimeRules(HardcoreRules()), results);
+    return true;
+  }
+
+  // Returns text as a JSON string
+  std::string quote(const std::string& text)
+  {
+    std::string quoted = "\"";
+    for (std::size_t i = 0; i < text.length(); i++)
+    {
+      if (text[i] == '"' || text[i] == '\\')
+      {
+        quoted += '\\';
+      }
+      if (static_cast<unsigned char>(text[i]) >= ' ')
+      {
+        quoted += text[i];
+      }
+    }
+    return quoted + "\"";
+  }
+
+  // Writes the results to filename as JSON; returns false if it could not
+  bool writeJson(const std::string& filename, const std::string& label,
+                 unsigned long long seed, int reps,
+                 const std::vector<Result>& results,
+                 const std::vector<Footprint>& footprints)
+  {
+    std::ofstream out(filename.c_str(), std::ios::out | std::ios::trunc);
+    out << std::fixed << std::setprecision(1)
+        << "{\n"
+        << "  \"label\": " << quote(label) << ",\n"
+        << "  \"time\": " << static_cast<long long>(std::time(nullptr))
+        << ",\n"
+        << "  \"seed\": " << seed << ",\n"
+        << "  \"reps\": " << reps << ",\n"
+        << "  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+      const Result& result = results[i];
+      long long cells = static_cast<long long>(result.rows) * result.cols;
+      out << (i == 0 ? "\n" : ",\n")
+          << "    {\"name\": " << quote(result.name)
+          << ", \"rows\": " << result.rows << ", \"cols\": " << result.cols
+          << ", \"cells\": " << cells << ", \"ops\": " << result.count
+          << ",\n     \"ns_per_op\": {\"min\": " << result.min
+          << ", \"median\": " << result.median << ", \"mean\": " << result.mean
+          << ", \"stddev\": " << result.stddev << "},\n"
+          << "     \"ops_per_sec\": " << 1e9 / result.median;
+      if (result.perSpace)
+      {
+        out << ", \"cells_per_sec\": " << cells * 1e9 / result.median;
+      }
+      out << ",\n     \"samples\": [";
+      for (std::size_t j = 0; j < result.samples.size(); j++)
+      {
+        out << (j == 0 ? "" : ", ") << result.samples[j];
+      }
+      out << "]}";
+    }
+    out << "\n  ],\n"
+        << "  \"memory\": [";
+    for (std::size_t i = 0; i < footprints.size(); i++)
+    {
+      const Footprint& footprint = footprints[i];
+      long long cells = static_cast<long long>(footprint.rows) * footprint.cols;
+      out << (i == 0 ? "\n" : ",\n")
+          << "    {\"rows\": " << footprint.rows << ", \"cols\": "
+          << footprint.cols << ", \"bytes\": " << footprint.bytes
+          << ", \"bytes_per_cell\": "
+          << static_cast<double>(footprint.bytes) / cells << "}";
+    }
+    out << "\n  ],\n"
+        << "  \"peak_rss\": " << MemoryStats::getPeakRss() << "\n}\n";
+    return static_cast<bool>(out);
+  }
+
+  // Prints one result as a line of the table
+  void printResult(const Result& result)
+  {
+    long long cells = static_cast<long long>(result.rows) * result.cols;
+    std::ostringstream size;
+    size << result.rows << "x" << result.cols;
+    std::cout << std::left << std::setw(17) << result.name << std::setw(11)
+              << size.str() << std::right << std::fixed << std::setprecision(1)
+              << std::setw(16) << result.median << " +-" << std::setw(6)
+              << (result.median > 0 ? 100 * result.stddev / result.median : 0)
+              << "%" << std::setprecision(0) << std::setw(14)
+              << 1e9 / result.median;
+    if (result.perSpace)
+    {
+      std::cout << std::setw(16) << cells * 1e9 / result.median;
+    }
+    std::cout << "\n";
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  std::string outFilename = "bench.json";
+  std::string label;
+  long long maxCells = 10000000;
+  int reps = 5;
+  unsigned long long seed = 1;
+
+  bool valid = argc % 2 == 1;
+  for (int i = 1; i + 1 < argc; i += 2)
+  {
+    std::string flag = argv[i];
+    std::string value = argv[i + 1];
+
+    if (flag == "-out")
+    {
+      outFilename = value;
+    }
+    else if (flag == "-max")
+    {
+      maxCells = std::atoll(value.c_str());
+    }
+    else if (flag == "-reps")
+    {
+      reps = std::atoi(value.c_str());
+    }
+    else if (flag == "-seed")
+    {
+      seed = std::strtoull(value.c_str(), nullptr, 10);
+    }
+    else if (flag == "-label")
+    {
+      label = value;
+    }
+    else
+    {
+      valid = false;
+    }
+  }
+
+  if (!valid || maxCells < SIZES[0][0] * SIZES[0][1] || reps < 1)
+  {
+    std::cout << "Usage: bench [-out file] [-max cells] [-reps n] [-seed n] "
+              << "[-label text]\n";
+    return 1;
+  }
+
+  std::cout << std::left << std::setw(17) << "benchmark" << std::setw(11)
+            << "map" << std::right << std::setw(16) << "ns/op (median)"
+            << std::setw(10) << "stddev" << std::setw(14) << "ops/sec"
+            << std::setw(16) << "spaces/sec" << "\n";
+
+  std::vector<Result> results;
+  std::vector<Footprint> footprints;
+  for (int i = 0; i < SIZE_COUNT; i++)
+  {
+    int rows = SIZES[i][0];
+    int cols = SIZES[i][1];
+    if (static_cast<long long>(rows) * cols > maxCells)
+    {
+      break;
+    }
+
+    std::size_t first = results.size();
+    Footprint footprint;
+    if (!benchSize(rows, cols, seed, reps, results, footprint))
+    {
+      std::cout << "Could not write " << MAP_FILENAME << "\n";
+      return 1;
+    }
+    for (std::size_t j = first; j < results.size(); j++)
+    {
+      printResult(results[j]);
+    }
+    footprints.push_back(footprint);
+  }
+
+  std::cout << "\n" << std::left << std::setw(17) << "memory" << std::setw(11)
+            << "map" << std::right << std::setw(16) << "bytes"
+            << std::setw(16) << "bytes/space" << "\n";
+  for (std::size_t i = 0; i < footprints.size(); i++)
+  {
+    const Footprint& footprint = footprints[i];
+    std::ostringstream size;
+    size << footprint.rows << "x" << footprint.cols;
+    std::cout << std::left << std::setw(17) << "board" << std::setw(11)
+              << size.str() << std::right << std::setw(16) << footprint.bytes
+              << std::setw(16) << std::setprecision(1)
+              << static_cast<double>(footprint.bytes) /
+                 (static_cast<long long>(footprint.rows) * footprint.cols)
+              << "\n";
+  }
+  std::cout << std::left << std::setw(28) << "peak resident set"
+            << std::right << std::setw(16) << MemoryStats::getPeakRss() << "\n";
+
+  if (!writeJson(outFilename, label, seed, reps, results, footprints))
+  {
+    std::cout << "Could not write " << outFilename << "\n";
+    return 1;
+  }
+  std::cout << "\nWrote " << outFilename << "\n";
+  return 0;
+}
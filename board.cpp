@@ -13,15 +13,46 @@
 #include "holeSpace.hpp"
 #include "wallSpace.hpp"
 #include "symbols.hpp" // constant chars for board symbols
+#include "bytes.hpp"
+#include "trace.hpp"
+#include "memoryStats.hpp"
+#include "embeddedMaps.hpp"
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
 #include <fstream>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 // --- Constructor ---
 Board::Board()
 {
+  spacesCreated = 0;
   readMap();
+  build();
+}
+
+// --- Constructor (map) ---
+// Creates a board from a map in the format produced by readMap: rows * cols
+// symbols, row by row
+Board::Board(const std::string& map, int rows, int cols)
+{
+  this->map = shareMap(map);
+  boardRows = rows;
+  boardCols = cols;
+  spacesCreated = 0;
+  build();
+}
 
+// --- build ---
+// Creates and links a space for every symbol in map, then puts the player at
+// the start
+void Board::build()
+{
+  Trace::Scope scope("build board", "load");
+  const std::string& map = *this->map;
   origin = createSpace(map.at(0));
 
   // Create board rows as linked structure
@@ -75,9 +106,35 @@ Board::Board()
   playerSpace->setPlayer(true);
 }
 
+// --- placePlayer ---
+// Moves the player straight to space, e.g. back to the start for a new game
+void Board::placePlayer(Space* space)
+{
+  playerSpace->setPlayer(false);
+  playerSpace = space;
+  playerSpace->setPlayer(true);
+}
+
+// --- Constructor (rows, cols) ---
+// Sets the board size without reading a map or creating any spaces; used by
+// derived boards, which must link their own spaces starting from origin
+Board::Board(int rows, int cols)
+{
+  boardRows = rows;
+  boardCols = cols;
+  origin = nullptr;
+  playerSpace = nullptr;
+  spacesCreated = 0;
+}
+
 // --- Destructor ---
 Board::~Board()
 {
+  if (origin == nullptr)
+  {
+    return; // no spaces were created
+  }
+
   Space* rowStart = origin;
   Space* current;
   Space* garbage;
@@ -101,6 +158,190 @@ Board::~Board()
   }
 }
 
+// --- getRows ---
+int Board::getRows()
+{
+  return boardRows;
+}
+
+// --- getCols ---
+int Board::getCols()
+{
+  return boardCols;
+}
+
+// --- getMap ---
+// Return the map the board was created from, as read by readMap
+std::string Board::getMap()
+{
+  return map ? *map : std::string();
+}
+
+// --- getSpace ---
+// Return the space at [row, col], counting from the top left corner, or
+// nullptr if there is no such space
+Space* Board::getSpace(int row, int col)
+{
+  if (row < 0 || row >= boardRows || col < 0 || col >= boardCols)
+  {
+    return nullptr;
+  }
+
+  Space* current = origin;
+  for (int i = 0; i < row; i++)
+  {
+    current = current->getAdjacent(Space::DOWN);
+  }
+  for (int j = 0; j < col; j++)
+  {
+    current = current->getAdjacent(Space::RIGHT);
+  }
+  return current;
+}
+
+// --- locate ---
+// Finds the row and column of space by walking to the edges of the board
+void Board::locate(Space* space, int& row, int& col)
+{
+  row = 0;
+  col = 0;
+  for (Space* current = space->getAdjacent(Space::LEFT); current != nullptr;
+       current = current->getAdjacent(Space::LEFT))
+  {
+    col++;
+  }
+  for (Space* current = space->getAdjacent(Space::UP); current != nullptr;
+       current = current->getAdjacent(Space::UP))
+  {
+    row++;
+  }
+}
+
+// --- saveState ---
+// Appends the player's position and the position and symbol of each space in
+// changed (paired with its symbol on the map) that still differs from the map
+// to out. Only the changed spaces are visited, so the state and the time to
+// save it grow with the number of changes rather than the size of the map.
+void Board::saveState(std::string& out,
+                      const std::vector<std::pair<Space*, char> >& changed)
+{
+  std::vector<std::pair<int, char> > changes;
+  for (std::size_t i = 0; i < changed.size(); i++)
+  {
+    Space* space = changed[i].first;
+    if (space->getDefaultSymbol() != changed[i].second)
+    {
+      int row;
+      int col;
+      locate(space, row, col);
+      changes.push_back(std::make_pair(row * boardCols + col,
+                                       space->getDefaultSymbol()));
+    }
+  }
+  std::sort(changes.begin(), changes.end());
+  changes.erase(std::unique(changes.begin(), changes.end()), changes.end());
+
+  int row;
+  int col;
+  locate(playerSpace, row, col);
+  Bytes::putInt(out, row * boardCols + col, 4);
+  Bytes::putInt(out, changes.size(), 4);
+  for (std::size_t i = 0; i < changes.size(); i++)
+  {
+    Bytes::putInt(out, changes[i].first, 4);
+    Bytes::putInt(out, changes[i].second, 1);
+  }
+}
+
+// --- loadState ---
+// Reads a state written by saveState from in at pos. The spaces in changed,
+// which must be every space that differs from the map, are put back first;
+// then the spaces changed in the state are changed again and replace the
+// contents of changed, and the player is moved. Returns false, changing
+// nothing, if the state does not fit this board.
+bool Board::loadState(const std::string& in, std::size_t& pos,
+                      std::vector<std::pair<Space*, char> >& changed)
+{
+  const std::string& map = *this->map;
+  long long cells = static_cast<long long>(boardRows) * boardCols;
+  unsigned long long playerCell;
+  unsigned long long changeCount;
+  std::size_t start = pos;
+  if (!Bytes::getInt(in, pos, 4, playerCell) ||
+      !Bytes::getInt(in, pos, 4, changeCount) ||
+      playerCell >= static_cast<unsigned long long>(cells) ||
+      map[playerCell] == WALL ||
+      changeCount > static_cast<unsigned long long>(cells))
+  {
+    pos = start;
+    return false;
+  }
+
+  // Changes are in cell order; only the rules can change a space, and they
+  // only ever empty one
+  std::vector<int> changes;
+  for (unsigned long long i = 0; i < changeCount; i++)
+  {
+    unsigned long long cell;
+    unsigned long long symbol;
+    if (!Bytes::getInt(in, pos, 4, cell) || !Bytes::getInt(in, pos, 1, symbol) ||
+        cell >= static_cast<unsigned long long>(cells) || map[cell] == WALL ||
+        map[cell] == EMPTY || symbol != static_cast<unsigned char>(EMPTY) ||
+        (!changes.empty() && static_cast<int>(cell) <= changes.back()))
+    {
+      pos = start;
+      return false;
+    }
+    changes.push_back(static_cast<int>(cell));
+  }
+
+  for (std::size_t i = changed.size(); i > 0; i--)
+  {
+    changed[i - 1].first->restore(changed[i - 1].second);
+  }
+  changed.clear();
+
+  for (std::size_t i = 0; i < changes.size(); i++)
+  {
+    Space* space = getSpace(changes[i] / boardCols, changes[i] % boardCols);
+    changed.push_back(std::make_pair(space, map[changes[i]]));
+    space->restore(EMPTY);
+  }
+
+  placePlayer(getSpace(playerCell / boardCols, playerCell % boardCols));
+  return true;
+}
+
+// --- hashMap ---
+// Returns the 64-bit FNV-1a hash of map, used to check that a replay or saved
+// game is used with the map it was made on
+unsigned long long Board::hashMap(const std::string& map)
+{
+  unsigned long long hash = 0xCBF29CE484222325ULL;
+  for (int i = 0, n = map.length(); i < n; i++)
+  {
+    hash ^= static_cast<unsigned char>(map[i]);
+    hash *= 0x100000001B3ULL;
+  }
+  return hash;
+}
+
+// --- shareMap ---
+// Returns a copy of map that boards can share, counted in MemoryStats for as
+// long as any board uses it
+std::shared_ptr<const std::string> Board::shareMap(const std::string& map)
+{
+  std::string* copy = new std::string(map);
+  long long bytes = MemoryStats::stringBytes(*copy);
+  MemoryStats::add(MemoryStats::MAPS, bytes);
+  return std::shared_ptr<const std::string>(copy,
+    [bytes](const std::string* text)
+    {
+      MemoryStats::remove(MemoryStats::MAPS, bytes);
+      delete text;
+    });
+}
+
 // --- getPlayerSpace ---
 // Return pointer to player's current location
 Space* Board::getPlayerSpace()
@@ -108,11 +349,27 @@ Space* Board::getPlayerSpace()
   return playerSpace;
 }
 
+// --- getSpacesCreated ---
+// Return the number of spaces created for the board so far; an endless cave
+// keeps creating them as the player explores
+long long Board::getSpacesCreated()
+{
+  return spacesCreated;
+}
+
 // --- print ---
 // Prints the board
 void Board::print()
 {
-  std::cout << "\n";
+  print(std::cout);
+}
+
+// --- print ---
+// Prints the board to out, e.g. for a player connected to the server
+void Board::print(std::ostream& out)
+{
+  Trace::Scope scope("print", "render");
+  out << "\n";
 
   Space* rowStart = origin;
   Space* current;
@@ -122,40 +379,44 @@ void Board::print()
     rowStart = rowStart->getAdjacent(Space::DOWN); // prepare to print next row
     for (int j = 0; j < boardCols; j++)
     {
-      std::cout << current->getSymbol() << " ";
+      out << current->getSymbol() << " ";
       current = current->getAdjacent(Space::RIGHT); // move right to next space
     }
-    std::cout << "\n";
+    out << "\n";
   }
 }
 
 // --- playerMove ---
-// Moves player in given direction; returns true if player was moved
+// Moves player in the direction given by a W, A, S or D key (upper or lower
+// case); returns true if player was moved
 bool Board::playerMove(char direction)
 {
-  Space* target;
-
   if (direction == 'W' || direction == 'w') // up
   {
-    target = playerSpace->getAdjacent(Space::UP);
+    return playerMove(Space::UP);
   }
   else if (direction == 'A' || direction == 'a') // left
   {
-    target = playerSpace->getAdjacent(Space::LEFT);
+    return playerMove(Space::LEFT);
   }
   else if (direction == 'S' || direction == 's') // down
   {
-    target = playerSpace->getAdjacent(Space::DOWN);
+    return playerMove(Space::DOWN);
   }
   else if (direction == 'D' || direction == 'd') // right
   {
-    target = playerSpace->getAdjacent(Space::RIGHT);
-  }
-  else
-  {
-    return false; // invalid input
+    return playerMove(Space::RIGHT);
   }
 
+  return false; // invalid input
+}
+
+// --- playerMove(direction) ---
+// Moves player in given direction; returns true if player was moved
+bool Board::playerMove(Space::Direction direction)
+{
+  Space* target = playerSpace->getAdjacent(direction);
+
   if (target != nullptr && target->isWalkable()) // if target is valid
   {
     playerSpace->setPlayer(false); // remove player from old location
@@ -172,34 +433,70 @@ bool Board::playerMove(char direction)
 // Gets the map data from .txt file to prepare for board creation
 void Board::readMap()
 {
+  Trace::Scope scope("readMap", "load");
+  std::string text;
+  if (!loadMap(mapFilename, text, boardRows, boardCols))
+  {
+    // Only if map.txt was left out of the built-in maps; use the first one
+    text = EmbeddedMaps::ALL[0].tiles;
+    boardRows = EmbeddedMaps::ALL[0].rows;
+    boardCols = EmbeddedMaps::ALL[0].cols;
+  }
+  map = shareMap(text);
+}
+
+// --- loadMap ---
+// Reads the map in filename into map, one line per row. If the file cannot be
+// opened, or EMBEDDED_MAPS_ONLY is defined, the map built in from a file of
+// the same name is copied instead. Returns false if there is neither.
+bool Board::loadMap(const std::string& filename, std::string& map, int& rows,
+                    int& cols)
+{
+  const EmbeddedMap* embedded = nullptr;
+  for (int i = 0; i < EmbeddedMaps::COUNT; i++)
+  {
+    if (filename == EmbeddedMaps::ALL[i].name)
+    {
+      embedded = &EmbeddedMaps::ALL[i];
+    }
+  }
+
   std::ifstream mapFile;
-  mapFile.open(mapFilename, std::ios::in);
+#ifndef EMBEDDED_MAPS_ONLY
+  mapFile.open(filename, std::ios::in);
+#endif
 
-  if (!mapFile)
+  if (!mapFile.is_open())
   {
-	  map = "######## @  ^## ^#  ##P#  ###^# @@###^@@E########"; // default map
-	  boardRows = 7;
-	  boardCols = 7;
-	  return;
+    if (embedded == nullptr)
+    {
+      return false;
+    }
+    map.assign(embedded->tiles, embedded->rows * embedded->cols);
+    rows = embedded->rows;
+    cols = embedded->cols;
+    return true;
   }
 
-  boardRows = 0;
-  boardCols = 0;
+  map = "";
+  rows = 0;
+  cols = 0;
 
   std::string line = "";
 
   getline(mapFile, line); // read first line from mapFile
-  boardCols = line.length(); // number of columns = length of first line
+  cols = line.length(); // number of columns = length of first line
   map += line;
-  boardRows++;
+  rows++;
 
   while (getline(mapFile, line)) // read each subsequent line from mapFile
   {
     map += line;
-    boardRows++; // number of rows = number of lines read in from file
+    rows++; // number of rows = number of lines read in from file
   }
 
   mapFile.close();
+  return true;
 }
 
 // --- createSpace ---
@@ -208,6 +505,7 @@ void Board::readMap()
 Space* Board::createSpace(char type)
 {
   Space* newSpace;
+  spacesCreated++;
 
   if (type == WALL)
   {
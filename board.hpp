@@ -10,33 +10,65 @@
 #define BOARD_HPP
 
 #include "space.hpp"
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 class Board
 {
-private:
+protected:
   int boardRows;
   int boardCols;
 
   Space* origin;
   Space* playerSpace;
+  long long spacesCreated; // by createSpace, over the board's life
 
   const std::string mapFilename = "map.txt";
-  std::string map; // string of chars used to read map.txt and create board from it
+  // string of chars used to read map.txt and create board from it; never
+  // changed, so boards on the same map can share it
+  std::shared_ptr<const std::string> map;
+
+  Board(int rows, int cols); // for boards that link their own spaces
+  void build(); // creates the spaces for map
 
 public:
   Board();
-  ~Board();
+  Board(const std::string& map, int rows, int cols);
+  virtual ~Board();
 
   // Get and set methods
+  int getRows();
+  int getCols();
+  std::string getMap();
+  virtual Space* getSpace(int row, int col);
+  virtual void locate(Space* space, int& row, int& col);
   Space* getPlayerSpace();
+  long long getSpacesCreated();
+  virtual void placePlayer(Space* space);
 
   // Gameplay methods
   void print();
-  bool playerMove(char direction);
+  virtual void print(std::ostream& out);
+  bool playerMove(char direction); // W, A, S or D
+  virtual bool playerMove(Space::Direction direction);
+
+  // Saved states: the player's position and every space changed by the
+  // rules; changed lists the changed spaces with their symbols on the map
+  virtual void saveState(std::string& out,
+                         const std::vector<std::pair<Space*, char> >& changed);
+  virtual bool loadState(const std::string& in, std::size_t& pos,
+                         std::vector<std::pair<Space*, char> >& changed);
 
   // Board creation methods
   void readMap(); // reads a 'map' of the game board from .txt file into string
+  static bool loadMap(const std::string& filename, std::string& map, int& rows,
+                      int& cols);
+  static unsigned long long hashMap(const std::string& map);
+  static std::shared_ptr<const std::string> shareMap(const std::string& map);
   Space* createSpace(char type); // allocates and returns a Space of given type
 };
 
@@ -0,0 +1,293 @@
+/*********************************************************************
+** Program name: broadcast.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Streams one game to any number of spectators. Each turn the
+** player's view of the game, a status line and the board, is compared with
+** the last one and the cells that changed are encoded once as a delta frame
+** of terminal escape codes. Every watcher is handed the same frame, so the
+** cost of a turn does not grow with the number of watchers. A watcher that
+** falls behind is sent a keyframe, the whole view, instead of the frames it
+** missed. BroadcastList finds the games being played on the server.
+*********************************************************************/
+
+#include "broadcast.hpp"
+#include <unistd.h>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+  // Unchanged characters between two changed ones that are sent again rather
+  // than moving the cursor past them, which takes about as many bytes
+  const std::size_t MAX_GAP = 6;
+
+  // Splits text into lines, dropping the newlines
+  void splitLines(const std::string& text, std::vector<std::string>& lines)
+  {
+    std::size_t start = 0;
+    std::size_t end;
+    while ((end = text.find('\n', start)) != std::string::npos)
+    {
+      lines.push_back(text.substr(start, end - start));
+      start = end + 1;
+    }
+    if (start < text.length())
+    {
+      lines.push_back(text.substr(start));
+    }
+  }
+
+  // Appends the escape code that moves the cursor to row and column, counting
+  // from 0
+  void moveTo(std::string& out, std::size_t row, std::size_t col)
+  {
+    out += "\x1b[" + std::to_string(static_cast<unsigned long long>(row + 1)) +
+           ";" + std::to_string(static_cast<unsigned long long>(col + 1)) + "H";
+  }
+}
+
+// --- Constructor ---
+Broadcast::Broadcast()
+{
+  end = 1;
+  closed = false;
+}
+
+// --- publish ---
+// Makes view, the text the player was just shown, the game's latest view and
+// sends the changes to every watcher as one frame. Called by the player's
+// thread only.
+void Broadcast::publish(const std::string& view)
+{
+  std::vector<std::string> after;
+  splitLines(view, after);
+
+  std::lock_guard<std::mutex> guard(lock);
+  if (closed)
+  {
+    return;
+  }
+
+  if (wakers.empty())
+  {
+    frames.clear(); // new watchers start from a keyframe
+  }
+  else
+  {
+    std::string delta = encodeDelta(lines, after);
+    if (!delta.empty())
+    {
+      frames.push_back(Frame(new std::string(delta)));
+      end++;
+      if (frames.size() > MAX_FRAMES)
+      {
+        frames.pop_front();
+      }
+    }
+  }
+  lines.swap(after);
+  keyframe.reset();
+  wake();
+}
+
+// --- close ---
+// Ends the broadcast once the game is over; watchers are sent the frames
+// published so far and then told that it has ended
+void Broadcast::close()
+{
+  std::lock_guard<std::mutex> guard(lock);
+  closed = true;
+  wake();
+}
+
+// --- wake ---
+// Tells every event loop with a watcher that there is something to pull;
+// called with lock held, so no loop can stop watching in the meantime
+void Broadcast::wake()
+{
+  std::uint64_t one = 1;
+  for (std::map<int, int>::iterator i = wakers.begin(); i != wakers.end(); ++i)
+  {
+    if (write(i->first, &one, sizeof(one)) < 0)
+    {
+      continue; // already signalled as many times as an eventfd counts
+    }
+  }
+}
+
+// --- watch ---
+// Adds a watcher whose event loop waits on the eventfd wakeFd
+void Broadcast::watch(int wakeFd)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  wakers[wakeFd]++;
+}
+
+// --- unwatch ---
+void Broadcast::unwatch(int wakeFd)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  std::map<int, int>::iterator found = wakers.find(wakeFd);
+  if (found != wakers.end() && --found->second == 0)
+  {
+    wakers.erase(found);
+  }
+}
+
+// --- pull ---
+// Adds the frames from number next onwards to out and sets next to the number
+// of the frame after them. If next is 0 or those frames are no longer kept, a
+// keyframe of the current view is added instead. Returns false once the game
+// is over.
+bool Broadcast::pull(unsigned long long& next, std::deque<Frame>& out)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  unsigned long long first = end - frames.size();
+  if (next == 0 || next < first)
+  {
+    if (!keyframe)
+    {
+      keyframe.reset(new std::string(encodeKeyframe(lines)));
+    }
+    out.push_back(keyframe);
+  }
+  else
+  {
+    for (unsigned long long i = next; i < end; i++)
+    {
+      out.push_back(frames[i - first]);
+    }
+  }
+  next = end;
+  return !closed;
+}
+
+// --- encodeDelta ---
+// Returns the escape codes and text that turn a terminal showing before into
+// one showing after, writing only the characters that changed, then moves the
+// cursor below the view; returns "" if nothing changed
+std::string Broadcast::encodeDelta(const std::vector<std::string>& before,
+                                   const std::vector<std::string>& after)
+{
+  std::string out;
+  const std::string none;
+  for (std::size_t i = 0; i < after.size(); i++)
+  {
+    const std::string& line = after[i];
+    const std::string& old = i < before.size() ? before[i] : none;
+
+    std::size_t j = 0;
+    while (j < line.length())
+    {
+      if (j < old.length() && old[j] == line[j])
+      {
+        j++;
+        continue;
+      }
+
+      // Extend the run of changes over short gaps of unchanged characters
+      std::size_t start = j;
+      std::size_t last = j;
+      for (j = start; j < line.length() && j - last <= MAX_GAP; j++)
+      {
+        if (j >= old.length() || old[j] != line[j])
+        {
+          last = j;
+        }
+      }
+      moveTo(out, i, start);
+      out.append(line, start, last + 1 - start);
+      j = last + 1;
+    }
+
+    if (old.length() > line.length())
+    {
+      moveTo(out, i, line.length());
+      out += "\x1b[K"; // clear the rest of the line
+    }
+  }
+
+  for (std::size_t i = after.size(); i < before.size(); i++)
+  {
+    moveTo(out, i, 0);
+    out += "\x1b[K";
+  }
+
+  if (!out.empty())
+  {
+    moveTo(out, after.size(), 0);
+  }
+  return out;
+}
+
+// --- encodeKeyframe ---
+// Returns the escape codes and text that clear a terminal and show view
+std::string Broadcast::encodeKeyframe(const std::vector<std::string>& view)
+{
+  std::string out = "\x1b[H\x1b[2J"; // cursor home, clear the screen
+  for (std::size_t i = 0; i < view.size(); i++)
+  {
+    out += view[i];
+    out += "\n";
+  }
+  return out;
+}
+
+// --- BroadcastList::add ---
+// Lists broadcast as the game played in session number, replacing the
+// session's last game
+void BroadcastList::add(long number, const std::shared_ptr<Broadcast>& broadcast)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  games[number] = broadcast;
+}
+
+// --- BroadcastList::remove ---
+// Takes broadcast off the list, unless the session has moved on to another
+// game already
+void BroadcastList::remove(long number,
+                           const std::shared_ptr<Broadcast>& broadcast)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  std::map<long, std::weak_ptr<Broadcast> >::iterator found =
+    games.find(number);
+  if (found != games.end() && found->second.lock() == broadcast)
+  {
+    games.erase(found);
+  }
+}
+
+// --- BroadcastList::find ---
+// Returns the game being played in session number, or nullptr if none is
+std::shared_ptr<Broadcast> BroadcastList::find(long number)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  std::map<long, std::weak_ptr<Broadcast> >::iterator found =
+    games.find(number);
+  if (found == games.end())
+  {
+    return std::shared_ptr<Broadcast>();
+  }
+  return found->second.lock();
+}
+
+// --- BroadcastList::list ---
+// Returns the numbers of up to limit sessions playing a game, lowest first
+std::vector<long> BroadcastList::list(std::size_t limit)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  std::vector<long> numbers;
+  for (std::map<long, std::weak_ptr<Broadcast> >::iterator i = games.begin();
+       i != games.end() && numbers.size() < limit; ++i)
+  {
+    numbers.push_back(i->first);
+  }
+  return numbers;
+}
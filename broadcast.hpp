@@ -0,0 +1,71 @@
+/*********************************************************************
+** Program name: broadcast.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Streams one game to any number of spectators. Each turn the
+** player's view of the game, a status line and the board, is compared with
+** the last one and the cells that changed are encoded once as a delta frame
+** of terminal escape codes. Every watcher is handed the same frame, so the
+** cost of a turn does not grow with the number of watchers. A watcher that
+** falls behind is sent a keyframe, the whole view, instead of the frames it
+** missed. BroadcastList finds the games being played on the server.
+*********************************************************************/
+
+#ifndef BROADCAST_HPP
+#define BROADCAST_HPP
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Broadcast
+{
+public:
+  typedef std::shared_ptr<const std::string> Frame;
+
+  static const std::size_t MAX_FRAMES = 64; // kept for watchers catching up
+
+private:
+  std::mutex lock; // guards everything below
+  std::vector<std::string> lines; // the view, line by line
+  std::deque<Frame> frames; // latest delta frames, oldest first
+  unsigned long long end; // number of the next frame; the first is 1
+  Frame keyframe; // the whole view, encoded when first needed
+  bool closed;
+  std::map<int, int> wakers; // eventfd to write on each frame, and its users
+
+  void wake();
+
+public:
+  Broadcast();
+
+  void publish(const std::string& view);
+  void close();
+
+  void watch(int wakeFd);
+  void unwatch(int wakeFd);
+  bool pull(unsigned long long& next, std::deque<Frame>& out);
+
+  static std::string encodeDelta(const std::vector<std::string>& before,
+                                 const std::vector<std::string>& after);
+  static std::string encodeKeyframe(const std::vector<std::string>& view);
+};
+
+class BroadcastList
+{
+private:
+  std::mutex lock;
+  std::map<long, std::weak_ptr<Broadcast> > games; // by session number
+
+public:
+  void add(long number, const std::shared_ptr<Broadcast>& broadcast);
+  void remove(long number, const std::shared_ptr<Broadcast>& broadcast);
+  std::shared_ptr<Broadcast> find(long number);
+  std::vector<long> list(std::size_t limit);
+};
+
+#endif
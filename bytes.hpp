@@ -0,0 +1,69 @@
+/*********************************************************************
+** Program name: bytes.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Helpers for packing numbers and strings into a string of
+** little-endian bytes and reading them back, used for saved game states
+*********************************************************************/
+
+#ifndef BYTES_HPP
+#define BYTES_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace Bytes
+{
+  // Appends value to out as size little-endian bytes
+  inline void putInt(std::string& out, unsigned long long value, int size)
+  {
+    for (int i = 0; i < size; i++)
+    {
+      out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+  }
+
+  // Reads size little-endian bytes from in at pos into value and moves pos
+  // past them; returns false if in is too short
+  inline bool getInt(const std::string& in, std::size_t& pos, int size,
+                     unsigned long long& value)
+  {
+    if (pos + size > in.length())
+    {
+      return false;
+    }
+
+    value = 0;
+    for (int i = 0; i < size; i++)
+    {
+      unsigned long long byte = static_cast<unsigned char>(in[pos + i]);
+      value |= byte << (8 * i);
+    }
+    pos += size;
+    return true;
+  }
+
+  // Appends text to out, preceded by its length
+  inline void putString(std::string& out, const std::string& text)
+  {
+    putInt(out, text.length(), 4);
+    out += text;
+  }
+
+  // Reads a string written by putString; returns false if in is too short
+  inline bool getString(const std::string& in, std::size_t& pos,
+                        std::string& text)
+  {
+    unsigned long long length;
+    if (!getInt(in, pos, 4, length) || pos + length > in.length())
+    {
+      return false;
+    }
+
+    text = in.substr(pos, length);
+    pos += length;
+    return true;
+  }
+}
+
+#endif
@@ -0,0 +1,160 @@
+/*********************************************************************
+** Program name: chunkCache.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Generates the chunks of an endless cave on a background
+** thread. Each chunk is a square map created from the cave's seed and the
+** chunk's position, so a chunk always looks the same however it is reached.
+*********************************************************************/
+
+#include "chunkCache.hpp"
+#include "levelGenerator.hpp"
+#include "memoryStats.hpp"
+#include "trace.hpp"
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace
+{
+  const std::size_t MAX_REQUESTS = 64;
+}
+
+// --- Constructor ---
+// Chunks are size x size spaces with open edges, so neighbouring chunks join
+// up into one continuous cave
+ChunkCache::ChunkCache(unsigned long long seed, int size)
+  : generator(size, size), requests(MAX_REQUESTS)
+{
+  this->seed = seed;
+  generator.setWalled(false);
+  generator.setChances(0.20, 0.08, 0.08);
+  generator.setPicks(1);
+
+  worker = std::thread(&ChunkCache::work, this);
+}
+
+// --- Destructor ---
+// Stops the background thread once it finishes its current chunk
+ChunkCache::~ChunkCache()
+{
+  requests.close();
+  worker.join();
+
+  for (std::map<Key, std::string>::iterator i = ready.begin();
+       i != ready.end(); i++)
+  {
+    MemoryStats::remove(MemoryStats::CACHES,
+                        MemoryStats::stringBytes(i->second));
+  }
+}
+
+// --- work ---
+// Background thread; generates requested chunks that are still wanted
+void ChunkCache::work()
+{
+  Trace::nameThread("chunk cache");
+  Key key;
+  while (requests.pop(key))
+  {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      if (wanted.find(key) == wanted.end() || ready.find(key) != ready.end())
+      {
+        continue; // already taken, forgotten or generated
+      }
+    }
+
+    std::string chunk = generate(key);
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (wanted.find(key) != wanted.end())
+    {
+      ready[key].swap(chunk);
+      MemoryStats::add(MemoryStats::CACHES,
+                       MemoryStats::stringBytes(ready[key]));
+    }
+  }
+}
+
+// --- generate ---
+// Creates the chunk at key; mixes the chunk's position into the cave's seed so
+// that every chunk gets its own, repeatable layout
+std::string ChunkCache::generate(Key key)
+{
+  Trace::Scope scope("generate chunk", "generator");
+  unsigned long long chunkSeed = seed;
+  chunkSeed ^= static_cast<unsigned long long>(key.first) * 0x9E3779B97F4A7C15ULL;
+  chunkSeed ^= static_cast<unsigned long long>(key.second) * 0xC2B2AE3D27D4EB4FULL;
+  chunkSeed ^= chunkSeed >> 31;
+  chunkSeed *= 0xBF58476D1CE4E5B9ULL;
+  chunkSeed ^= chunkSeed >> 27;
+
+  return generator.generate(chunkSeed);
+}
+
+// --- prefetch ---
+// Asks the background thread to generate the chunk at key before it is needed
+void ChunkCache::prefetch(Key key)
+{
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!wanted.insert(key).second)
+    {
+      return; // already requested
+    }
+  }
+  requests.push(key);
+}
+
+// --- take ---
+// Returns the chunk at key, generating it now if the background thread has not
+// got to it yet
+std::string ChunkCache::take(Key key)
+{
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    wanted.erase(key);
+
+    std::map<Key, std::string>::iterator found = ready.find(key);
+    if (found != ready.end())
+    {
+      std::string chunk;
+      chunk.swap(found->second);
+      MemoryStats::remove(MemoryStats::CACHES, MemoryStats::stringBytes(chunk));
+      ready.erase(found);
+      return chunk;
+    }
+  }
+
+  return generate(key);
+}
+
+// --- retain ---
+// Forgets requested chunks more than radius chunks away from center, so the
+// cache never holds more than the area around the player
+void ChunkCache::retain(Key center, int radius)
+{
+  std::lock_guard<std::mutex> guard(lock);
+
+  for (std::set<Key>::iterator i = wanted.begin(); i != wanted.end();)
+  {
+    if (std::llabs(i->first - center.first) > radius ||
+        std::llabs(i->second - center.second) > radius)
+    {
+      std::map<Key, std::string>::iterator found = ready.find(*i);
+      if (found != ready.end())
+      {
+        MemoryStats::remove(MemoryStats::CACHES,
+                            MemoryStats::stringBytes(found->second));
+        ready.erase(found);
+      }
+      wanted.erase(i++);
+    }
+    else
+    {
+      i++;
+    }
+  }
+}
@@ -0,0 +1,49 @@
+/*********************************************************************
+** Program name: chunkCache.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Generates the chunks of an endless cave on a background
+** thread. Each chunk is a square map created from the cave's seed and the
+** chunk's position, so a chunk always looks the same however it is reached.
+*********************************************************************/
+
+#ifndef CHUNKCACHE_HPP
+#define CHUNKCACHE_HPP
+
+#include "levelGenerator.hpp"
+#include "workQueue.hpp"
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+
+class ChunkCache
+{
+public:
+  typedef std::pair<long long, long long> Key; // chunk row, chunk column
+
+private:
+  unsigned long long seed;
+  LevelGenerator generator;
+
+  WorkQueue<Key> requests;
+  std::set<Key> wanted; // chunks requested and not yet taken
+  std::map<Key, std::string> ready; // chunks generated ahead of time
+  std::mutex lock;
+  std::thread worker;
+
+  void work();
+  std::string generate(Key key);
+
+public:
+  ChunkCache(unsigned long long seed, int size);
+  ~ChunkCache();
+
+  void prefetch(Key key);
+  std::string take(Key key);
+  void retain(Key center, int radius);
+};
+
+#endif
@@ -0,0 +1,289 @@
+/*********************************************************************
+** Program name: crowd.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Measures how fast a SharedCave takes actions as more and more
+** players share it. For each player count, a fresh cave is filled with that
+** many players, and the worker threads take random actions for them, mostly
+** moves, for a fixed time. A player whose game ends joins again at once, so
+** the count stays the same. Reports actions and moves per second, how often a
+** move was blocked by another player and how many items were taken.
+**
+** Without -map, the cave is the top left -size x -size spaces of the endless
+** cave made from the seed, walled in, so that holes, rocks and pickaxes are
+** spread all through it for the players to race for.
+**
+** Usage: crowd [-map file | -size n] [-players n,n,...] [-threads n]
+**              [-ms n] [-seed n]
+*********************************************************************/
+
+#include "sharedCave.hpp"
+#include "board.hpp"
+#include "event.hpp"
+#include "gameState.hpp"
+#include "chunkCache.hpp"
+#include "player.hpp"
+#include "space.hpp"
+#include "symbols.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  const GameState::Action ACTIONS[] = {
+    GameState::MOVE_UP, GameState::MOVE_DOWN, GameState::MOVE_LEFT,
+    GameState::MOVE_RIGHT, GameState::MOVE_UP, GameState::MOVE_DOWN,
+    GameState::MOVE_LEFT, GameState::MOVE_RIGHT, GameState::INSPECT };
+  const int ACTION_COUNT = sizeof(ACTIONS) / sizeof(ACTIONS[0]);
+  const int CHUNK_SIZE = 8; // as in the endless cave
+
+  // What one worker did
+  struct Counts
+  {
+    long actions;
+    long moves;
+    long blocked; // moves onto another player's space
+    long items; // pickaxes taken and rocks mined
+    long games; // games finished
+  };
+
+  // Returns a rows x cols map cut from the endless cave made from seed, with
+  // walls around it and the start at [1,1] open
+  std::string caveMap(unsigned long long seed, int rows, int cols)
+  {
+    ChunkCache chunks(seed, CHUNK_SIZE);
+    std::string map(rows * cols, WALL);
+    for (int i = 0; i < rows; i += CHUNK_SIZE)
+    {
+      for (int j = 0; j < cols; j += CHUNK_SIZE)
+      {
+        std::string chunk = chunks.take(ChunkCache::Key(i / CHUNK_SIZE,
+                                                        j / CHUNK_SIZE));
+        for (int k = 0; k < CHUNK_SIZE * CHUNK_SIZE; k++)
+        {
+          int row = i + k / CHUNK_SIZE;
+          int col = j + k % CHUNK_SIZE;
+          if (row > 0 && row < rows - 1 && col > 0 && col < cols - 1)
+          {
+            map[row * cols + col] = chunk[k];
+          }
+        }
+      }
+    }
+    map[cols + 1] = EMPTY;
+    map[cols + 2] = EMPTY;
+    map[2 * cols + 1] = EMPTY;
+    return map;
+  }
+
+  // Returns the random seed for worker number worker
+  unsigned long long workerSeed(unsigned long long seed, int worker)
+  {
+    unsigned long long mixed = seed + 0x9E3779B97F4A7C15ULL * (worker + 1);
+    mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+    return mixed ^ (mixed >> 31);
+  }
+
+  // Takes random actions for every threads-th caver, starting from first,
+  // until deadline, and adds up what happened in counts
+  void play(SharedCave& cave, std::vector<SharedCave::Caver*>& cavers,
+            int first, int threads, unsigned long long random,
+            std::chrono::steady_clock::time_point deadline, Counts& counts)
+  {
+    Counts local = { 0, 0, 0, 0, 0 };
+    while (first < static_cast<int>(cavers.size()) &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+      for (int i = first, n = cavers.size(); i < n; i += threads)
+      {
+        if (cavers[i] == nullptr) // the cave was full; try again
+        {
+          cavers[i] = cave.join();
+          continue;
+        }
+
+        random ^= random >> 12; // xorshift64*
+        random ^= random << 25;
+        random ^= random >> 27;
+        GameState::Action action =
+          ACTIONS[((random * 0x2545F4914F6CDD1DULL) >> 32) % ACTION_COUNT];
+        if (cavers[i]->getOffer() != Space::NO_OFFER)
+        {
+          action = GameState::ACCEPT;
+        }
+
+        const GameState::Outcome& outcome = cave.step(cavers[i], action);
+        local.actions++;
+        local.moves += outcome.moved ? 1 : 0;
+        for (int j = 0, m = outcome.events.size(); j < m; j++)
+        {
+          local.blocked += outcome.events[j].type == Event::BLOCKED ? 1 : 0;
+          local.items += outcome.events[j].type == Event::PICK_TAKEN ||
+                         outcome.events[j].type == Event::ROCKS_MINED ? 1 : 0;
+        }
+
+        if (cavers[i]->getPlayer()->getState() != Player::PLAYING)
+        {
+          local.games++;
+          cave.leave(cavers[i]);
+          cavers[i] = cave.join();
+        }
+      }
+    }
+    counts = local; // written once, by this worker only
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  std::string mapFilename;
+  int size = 256;
+  std::string playerList = "1,10,100,1000,2000,4000";
+  int milliseconds = 1000;
+  unsigned long long seed = 1;
+  int threads = std::thread::hardware_concurrency();
+  if (threads < 1)
+  {
+    threads = 1;
+  }
+
+  bool valid = argc % 2 == 1;
+  for (int i = 1; i + 1 < argc; i += 2)
+  {
+    std::string flag = argv[i];
+    std::string value = argv[i + 1];
+
+    if (flag == "-map")
+    {
+      mapFilename = value;
+    }
+    else if (flag == "-size")
+    {
+      size = std::atoi(value.c_str());
+    }
+    else if (flag == "-players")
+    {
+      playerList = value;
+    }
+    else if (flag == "-threads")
+    {
+      threads = std::atoi(value.c_str());
+    }
+    else if (flag == "-ms")
+    {
+      milliseconds = std::atoi(value.c_str());
+    }
+    else if (flag == "-seed")
+    {
+      seed = std::strtoull(value.c_str(), nullptr, 10);
+    }
+    else
+    {
+      valid = false;
+    }
+  }
+
+  std::vector<int> counts;
+  std::istringstream players(playerList);
+  std::string count;
+  while (std::getline(players, count, ','))
+  {
+    counts.push_back(std::atoi(count.c_str()));
+    valid = valid && counts.back() > 0;
+  }
+
+  if (!valid || counts.empty() || size < 3 || threads <= 0 ||
+      milliseconds <= 0)
+  {
+    std::cout << "Usage: crowd [-map file | -size n] [-players n,n,...] "
+              << "[-threads n] [-ms n] [-seed n]\n";
+    return 1;
+  }
+
+  std::string map;
+  int rows = size;
+  int cols = size;
+  if (mapFilename.empty())
+  {
+    map = caveMap(seed, rows, cols);
+    mapFilename = "endless cave";
+  }
+  else if (!Board::loadMap(mapFilename, map, rows, cols))
+  {
+    std::cout << "Could not read " << mapFilename << "\n";
+    return 1;
+  }
+
+  std::cout << "Map " << mapFilename << " (" << rows << "x" << cols << "), "
+            << threads << " threads, " << milliseconds << " ms each\n\n"
+            << "  players   actions/sec     moves/sec   blocked      items"
+            << "   games/sec\n";
+
+  for (int c = 0, n = counts.size(); c < n; c++)
+  {
+    SharedCave cave(map, rows, cols);
+    std::vector<SharedCave::Caver*> cavers;
+    for (int i = 0; i < counts[c]; i++)
+    {
+      SharedCave::Caver* caver = cave.join();
+      if (caver == nullptr)
+      {
+        break; // no free space left
+      }
+      cavers.push_back(caver);
+    }
+
+    std::vector<Counts> results(threads);
+    std::vector<std::thread> workers;
+    std::chrono::steady_clock::time_point started =
+      std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point deadline =
+      started + std::chrono::milliseconds(milliseconds);
+    for (int t = 0; t < threads; t++)
+    {
+      workers.push_back(std::thread(play, std::ref(cave), std::ref(cavers), t,
+                                    threads, workerSeed(seed, t), deadline,
+                                    std::ref(results[t])));
+    }
+
+    Counts total = { 0, 0, 0, 0, 0 };
+    for (int t = 0; t < threads; t++)
+    {
+      workers[t].join();
+      total.actions += results[t].actions;
+      total.moves += results[t].moves;
+      total.blocked += results[t].blocked;
+      total.items += results[t].items;
+      total.games += results[t].games;
+    }
+    double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - started).count();
+
+    for (int i = 0, m = cavers.size(); i < m; i++)
+    {
+      if (cavers[i] != nullptr)
+      {
+        cave.leave(cavers[i]);
+      }
+    }
+
+    long tries = total.moves + total.blocked;
+    std::cout << std::fixed << std::setprecision(0)
+              << std::setw(9) << cavers.size()
+              << std::setw(14) << total.actions / seconds
+              << std::setw(14) << total.moves / seconds
+              << std::setw(9) << std::setprecision(1)
+              << (tries > 0 ? 100.0 * total.blocked / tries : 0) << "%"
+              << std::setw(11) << total.items
+              << std::setw(12) << std::setprecision(0)
+              << total.games / seconds << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,210 @@
+/*********************************************************************
+** Program name: dfsSolver.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Finds the shortest win from the current point of a game by
+** depth-first search on the game itself. Each move is tried with
+** GameState::step and taken back with GameState::rollback, which undoes only
+** what the move changed, so the board is never copied however many positions
+** are searched. Unlike LevelSolver, it needs no model of the rules of its own.
+*********************************************************************/
+
+#include "dfsSolver.hpp"
+#include "gameState.hpp"
+#include "event.hpp"
+#include "player.hpp"
+#include "symbols.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+  const GameState::Action MOVES[] = { GameState::MOVE_UP, GameState::MOVE_LEFT,
+                                      GameState::MOVE_DOWN,
+                                      GameState::MOVE_RIGHT };
+  const char KEYS[] = { 'W', 'A', 'S', 'D' };
+
+  // Hash of a space, for the set of changed spaces
+  std::uint64_t hashSpace(Space* space)
+  {
+    std::uint64_t h = reinterpret_cast<std::uintptr_t>(space);
+    h *= 0x9E3779B97F4A7C15ULL;
+    return h ^ (h >> 31);
+  }
+
+  // Returns true if events include a change to the player's space
+  bool changedSpace(const EventList& events)
+  {
+    for (std::size_t i = 0; i < events.size(); i++)
+    {
+      if (events[i].type == Event::HOLE_FILLED ||
+          events[i].type == Event::ROCKS_MINED ||
+          events[i].type == Event::PICK_TAKEN)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+}
+
+// --- Key::operator== ---
+bool DfsSolver::Key::operator==(const Key& other) const
+{
+  return space == other.space && rocks == other.rocks &&
+         picks == other.picks && changed == other.changed;
+}
+
+// --- KeyHash::operator() ---
+std::size_t DfsSolver::KeyHash::operator()(const Key& key) const
+{
+  std::uint64_t h = hashSpace(key.space) ^ key.changed;
+  h ^= (key.rocks << 2) | key.picks;
+  h *= 0xC2B2AE3D27D4EB4FULL;
+  return static_cast<std::size_t>(h ^ (h >> 29));
+}
+
+// --- Constructor ---
+// Searches state, which must not be an endless cave
+DfsSolver::DfsSolver(GameState& state) : state(state)
+{
+  maxNodes = 0;
+  nodes = 0;
+  aborted = false;
+}
+
+// --- makeKey ---
+// Returns the key of the current position, given the hash of the spaces
+// changed so far
+DfsSolver::Key DfsSolver::makeKey(std::uint64_t changed)
+{
+  const Player::Inventory& inventory = state.getPlayer()->getInventory();
+
+  Key key = { state.getBoard()->getPlayerSpace(), 0, 0, changed };
+  for (std::size_t i = 0; i < inventory.size(); i++)
+  {
+    if (inventory[i] == ROCK)
+    {
+      key.rocks++;
+    }
+    else
+    {
+      key.picks++;
+    }
+  }
+  return key;
+}
+
+// --- search ---
+// Returns true if the exit can be reached in at most movesLeft moves, leaving
+// the game at the win and the moves in path; otherwise leaves both as they
+// were. Taking an item costs no step, so it is tried before moving on.
+bool DfsSolver::search(int movesLeft, std::uint64_t changed)
+{
+  if (++nodes > maxNodes)
+  {
+    aborted = true;
+    return false;
+  }
+
+  Key key = makeKey(changed);
+  std::unordered_map<Key, int, KeyHash>::iterator found = searched.find(key);
+  if (found != searched.end() && found->second >= movesLeft)
+  {
+    return false; // already searched with as many moves or more
+  }
+  searched[key] = movesLeft;
+
+  GameState::Mark mark = state.getMark();
+
+  if (state.step(GameState::INSPECT).offer != Space::NO_OFFER)
+  {
+    const GameState::Outcome& outcome = state.step(GameState::ACCEPT);
+    if (changedSpace(outcome.events))
+    {
+      path += 'E';
+      if (search(movesLeft,
+                 changed ^ hashSpace(state.getBoard()->getPlayerSpace())))
+      {
+        return true;
+      }
+      path.erase(path.length() - 1);
+    }
+    state.rollback(mark);
+  }
+
+  for (int i = 0; i < 4 && movesLeft > 0 && !aborted; i++)
+  {
+    const GameState::Outcome& outcome = state.step(MOVES[i]);
+    if (!outcome.moved)
+    {
+      continue; // a wall; nothing changed
+    }
+
+    std::uint64_t next = changed;
+    if (changedSpace(outcome.events))
+    {
+      next ^= hashSpace(state.getBoard()->getPlayerSpace());
+    }
+
+    path += KEYS[i];
+    Player::State result = state.getPlayer()->getState();
+    if (result == Player::WIN ||
+        (result == Player::PLAYING && search(movesLeft - 1, next)))
+    {
+      return true;
+    }
+    path.erase(path.length() - 1);
+    state.rollback(mark);
+  }
+
+  return false;
+}
+
+// --- solve ---
+// Searches for the shortest win from the current point of the game, giving up
+// after maxNodes positions, by searching with one more move allowed each time
+// until a win is found. The game is left as it was.
+DfsSolver::Result DfsSolver::solve(long maxNodes)
+{
+  Trace::Scope scope("depth-first solve", "solver");
+  Result result;
+  result.solved = false;
+  result.aborted = false;
+  result.steps = 0;
+  result.nodes = 0;
+
+  if (state.getPlayer()->isEndless() ||
+      state.getPlayer()->getState() != Player::PLAYING)
+  {
+    return result;
+  }
+
+  this->maxNodes = maxNodes;
+  nodes = 0;
+  aborted = false;
+  GameState::Mark start = state.getMark();
+
+  for (int moves = 0; moves <= state.getSteps() && !aborted; moves++)
+  {
+    searched.clear();
+    path.clear();
+    if (search(moves, 0))
+    {
+      result.solved = true;
+      result.steps = path.length() - std::count(path.begin(), path.end(), 'E');
+      result.moves = path;
+      break;
+    }
+  }
+
+  state.rollback(start);
+  searched.clear();
+  result.aborted = aborted;
+  result.nodes = nodes;
+  return result;
+}
@@ -0,0 +1,69 @@
+/*********************************************************************
+** Program name: dfsSolver.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Finds the shortest win from the current point of a game by
+** depth-first search on the game itself. Each move is tried with
+** GameState::step and taken back with GameState::rollback, which undoes only
+** what the move changed, so the board is never copied however many positions
+** are searched. Unlike LevelSolver, it needs no model of the rules of its own.
+*********************************************************************/
+
+#ifndef DFSSOLVER_HPP
+#define DFSSOLVER_HPP
+
+#include "gameState.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+class DfsSolver
+{
+public:
+  struct Result
+  {
+    bool solved; // true if the exit can be reached with the steps left
+    bool aborted; // true if the search gave up after too many positions
+    int steps; // moves taken by the shortest win
+    long nodes; // positions searched
+    std::string moves; // W/A/S/D to move, E to inspect and accept the offer
+  };
+
+private:
+  // A position: the player's space and inventory, and the set of spaces the
+  // rules have changed, as the xor of a hash of each
+  struct Key
+  {
+    Space* space;
+    int rocks;
+    int picks;
+    std::uint64_t changed;
+
+    bool operator==(const Key& other) const;
+  };
+
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  GameState& state;
+  long maxNodes;
+  long nodes;
+  bool aborted;
+  std::string path; // moves from the start of the search to here
+
+  // Most moves left with which each position has been searched
+  std::unordered_map<Key, int, KeyHash> searched;
+
+  Key makeKey(std::uint64_t changed);
+  bool search(int movesLeft, std::uint64_t changed);
+
+public:
+  DfsSolver(GameState& state);
+
+  Result solve(long maxNodes);
+};
+
+#endif
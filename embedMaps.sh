@@ -0,0 +1,107 @@
+#!/bin/sh
+#*********************************************************************
+# Program name: embedMaps.sh
+# Author: Jesse McKenna
+# Date: 10/19/2026
+# Description: Turns map files into embeddedMaps.hpp, a header of EmbeddedMap
+# entries kept as read-only data in the program. Each map is checked here for
+# rows of equal length, and by static_asserts at compile time for its size,
+# its symbols, an exit and an open start. Each map is named after its file,
+# e.g. map.txt becomes EmbeddedMaps::MAP.
+#
+# Usage: embedMaps.sh mapfile... > embeddedMaps.hpp
+#*********************************************************************
+
+if [ $# -eq 0 ]
+then
+  echo "Usage: embedMaps.sh mapfile... > embeddedMaps.hpp" >&2
+  exit 1
+fi
+
+cat <<'END'
+/*********************************************************************
+** Program name: embeddedMaps.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Maps built into the program, generated by embedMaps.sh from
+** the map files listed in the makefile. Do not edit; change the map files and
+** run make instead.
+*********************************************************************/
+
+#ifndef EMBEDDEDMAPS_HPP
+#define EMBEDDEDMAPS_HPP
+
+#include "embeddedMap.hpp"
+
+namespace EmbeddedMaps
+{
+END
+
+names=""
+for file in "$@"
+do
+  name=$(basename "$file" | sed 's/\.[^.]*$//' | tr 'a-z' 'A-Z' |
+         sed 's/[^A-Z0-9]/_/g')
+  awk -v file="$file" -v name="$name" '
+    {
+      if (NR == 1)
+      {
+        cols = length($0)
+      }
+      else if (length($0) != cols)
+      {
+        printf "%s:%d: row is %d wide, not %d\n", file, NR, length($0),
+               cols > "/dev/stderr"
+        failed = 1
+        exit 1
+      }
+      line = $0
+      gsub(/\\/, "\\\\", line)
+      gsub(/"/, "\\\"", line)
+      rows[NR] = line
+    }
+    END {
+      if (failed)
+      {
+        exit 1
+      }
+      if (NR == 0)
+      {
+        printf "%s: empty map\n", file > "/dev/stderr"
+        exit 1
+      }
+      cells = NR * cols
+      printf "  // %s\n", file
+      printf "  constexpr char %s_TILES[] =\n", name
+      for (i = 1; i <= NR; i++)
+      {
+        printf "    \"%s\"%s\n", rows[i], i == NR ? ";" : ""
+      }
+      printf "  constexpr EmbeddedMap %s = { \"%s\", %s_TILES, %d, %d };\n",
+             name, file, name, NR, cols
+      printf "  static_assert(sizeof(%s_TILES) - 1 == %d,\n", name, cells
+      printf "                \"%s: tiles do not fill %d x %d\");\n", file, NR,
+             cols
+      printf "  static_assert(EmbeddedMap::allKnown(%s_TILES, 0, %d),\n", name,
+             cells
+      printf "                \"%s: unknown symbol\");\n", file
+      printf "  static_assert(EmbeddedMap::count(%s_TILES, 0, %d, EXIT) > 0,\n",
+             name, cells
+      printf "                \"%s: no exit\");\n", file
+      printf "  static_assert(EmbeddedMap::openStart(%s_TILES, %d, %d),\n", name,
+             NR, cols
+      printf "                \"%s: start at row 1, column 1 is not empty\");\n",
+             file
+      printf "\n"
+    }' "$file" || exit 1
+  names="$names${names:+, }$name"
+done
+
+cat <<END
+  // Every embedded map, in the order the files were given
+  constexpr EmbeddedMap ALL[] = { $names };
+  const int COUNT = sizeof(ALL) / sizeof(ALL[0]);
+}
+
+#endif
+END
@@ -0,0 +1,60 @@
+/*********************************************************************
+** Program name: embeddedMap.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: A map built into the program as read-only data, in the same
+** row-major format Board::loadMap produces. embedMaps.sh turns map files into
+** EmbeddedMaps entries whose checks run at compile time, so a broken map
+** stops the build instead of the game. A board is created from one without
+** opening or parsing any file.
+*********************************************************************/
+
+#ifndef EMBEDDEDMAP_HPP
+#define EMBEDDEDMAP_HPP
+
+#include "symbols.hpp"
+
+struct EmbeddedMap
+{
+  const char* name; // file the map was embedded from
+  const char* tiles; // rows * cols symbols, row by row
+  int rows;
+  int cols;
+
+  // Returns the number of tiles[begin..end) equal to symbol. Splits the range
+  // in half each time, so that large maps stay within the compiler's limit
+  // on constexpr recursion.
+  static constexpr int count(const char* tiles, int begin, int end,
+                             char symbol)
+  {
+    return end - begin == 0 ? 0 :
+           end - begin == 1 ? (tiles[begin] == symbol ? 1 : 0) :
+           count(tiles, begin, (begin + end) / 2, symbol) +
+           count(tiles, (begin + end) / 2, end, symbol);
+  }
+
+  // Returns true if symbol stands for a space or an item
+  static constexpr bool known(char symbol)
+  {
+    return symbol == EMPTY || symbol == WALL || symbol == HOLE ||
+           symbol == EXIT || symbol == ROCK || symbol == PICK;
+  }
+
+  // Returns true if every one of tiles[begin..end) is a known symbol
+  static constexpr bool allKnown(const char* tiles, int begin, int end)
+  {
+    return end - begin == 0 ? true :
+           end - begin == 1 ? known(tiles[begin]) :
+           allKnown(tiles, begin, (begin + end) / 2) &&
+           allKnown(tiles, (begin + end) / 2, end);
+  }
+
+  // Returns true if the player can start on the map: Board::build puts the
+  // player at row 1, column 1, which must be empty
+  static constexpr bool openStart(const char* tiles, int rows, int cols)
+  {
+    return rows >= 2 && cols >= 2 && tiles[cols + 1] == EMPTY;
+  }
+};
+
+#endif
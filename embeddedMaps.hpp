@@ -0,0 +1,41 @@
+/*********************************************************************
+** Program name: embeddedMaps.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Maps built into the program, generated by embedMaps.sh from
+** the map files listed in the makefile. Do not edit; change the map files and
+** run make instead.
+*********************************************************************/
+
+#ifndef EMBEDDEDMAPS_HPP
+#define EMBEDDEDMAPS_HPP
+
+#include "embeddedMap.hpp"
+
+namespace EmbeddedMaps
+{
+  // map.txt
+  constexpr char MAP_TILES[] =
+    "#######"
+    "# @  ^#"
+    "# ^#  #"
+    "#P#  ##"
+    "#^# @@#"
+    "##^@@E#"
+    "#######";
+  constexpr EmbeddedMap MAP = { "map.txt", MAP_TILES, 7, 7 };
+  static_assert(sizeof(MAP_TILES) - 1 == 49,
+                "map.txt: tiles do not fill 7 x 7");
+  static_assert(EmbeddedMap::allKnown(MAP_TILES, 0, 49),
+                "map.txt: unknown symbol");
+  static_assert(EmbeddedMap::count(MAP_TILES, 0, 49, EXIT) > 0,
+                "map.txt: no exit");
+  static_assert(EmbeddedMap::openStart(MAP_TILES, 7, 7),
+                "map.txt: start at row 1, column 1 is not empty");
+
+  // Every embedded map, in the order the files were given
+  constexpr EmbeddedMap ALL[] = { MAP };
+  const int COUNT = sizeof(ALL) / sizeof(ALL[0]);
+}
+
+#endif
@@ -8,8 +8,8 @@
 #include "emptySpace.hpp"
 #include "player.hpp"
 #include "symbols.hpp"
-#include "menu.hpp"
-#include <iostream>
+#include "memoryStats.hpp"
+#include <cstddef>
 
 // --- Constructor ---
 EmptySpace::EmptySpace()
@@ -24,59 +24,91 @@ EmptySpace::~EmptySpace()
 {
 }
 
+// --- operator new ---
+void* EmptySpace::operator new(std::size_t size)
+{
+  return MemoryStats::allocate(MemoryStats::EMPTY_SPACES, size);
+}
+
+// --- operator delete ---
+void EmptySpace::operator delete(void* pointer, std::size_t size)
+{
+  MemoryStats::release(MemoryStats::EMPTY_SPACES, pointer, size);
+}
+
 // --- arrive ---
 // Executes upon player arriving in a space;
 // does nothing for an empty space
-void EmptySpace::arrive(Player* player)
+void EmptySpace::arrive(Player* player, EventList& events)
 {
 }
 
 // --- inspect ---
-// Executes upon player choosing to inspect current space
-void EmptySpace::inspect(Player* player)
+// Executes upon player choosing to inspect current space; returns the choice
+// offered to the player, if any, which is carried out by accept
+Space::Offer EmptySpace::inspect(Player* player, EventList& events)
 {
   if (defaultSymbol == ROCK)
   {
-    std::cout << "\nA formation of large rocks.\n";
+    Event found = { Event::ROCKS_FOUND, 0 };
+    events.push_back(found);
 
     if (player->hasItem(PICK) && player->inventoryFull())
     {
-      std::cout << "You have a pickaxe, but your inventory is full.\n";
+      Event full = { Event::HAVE_PICK_FULL, 0 };
+      events.push_back(full);
     }
     else if (player->hasItem(PICK) && !player->inventoryFull())
     {
-      std::cout << "You have a pickaxe.\n";
-      Menu mineMenu(2);
-      mineMenu.setPrompt(1, "Mine the rocks");
-      mineMenu.setPrompt(2, "Do nothing");
-
-      if (mineMenu.showMenu() == 1) // player chooses to mine rocks
-      {
-        player->addItem(ROCK); // add rock to inventory
-        defaultSymbol = EMPTY; // remove rock from space
-      }
+      Event pick = { Event::HAVE_PICK, 0 };
+      events.push_back(pick);
+      return MINE_ROCKS;
     }
   }
   else if (defaultSymbol == PICK)
   {
-    std::cout << "\nA pickaxe.\n";
+    Event found = { Event::PICK_FOUND, 0 };
+    events.push_back(found);
 
     if (!player->inventoryFull())
     {
-      Menu pickMenu(2);
-      pickMenu.setPrompt(1, "Take the pickaxe");
-      pickMenu.setPrompt(2, "Do nothing");
-
-      if (pickMenu.showMenu() == 1) // player chooses to take pickaxe
-      {
-        player->addItem(PICK); // add pick to inventory
-        defaultSymbol = EMPTY; // remove pick from space
-      }
+      return TAKE_PICK;
     }
   }
   else
   {
-    std::cout << "\nFound nothing of interest.\n";
+    Event nothing = { Event::NOTHING_FOUND, 0 };
+    events.push_back(nothing);
+  }
+
+  return NO_OFFER;
+}
+
+// --- accept ---
+// Executes upon player accepting the offer made by inspect: mines the rocks
+// or takes the pickaxe, if the player is still able to
+void EmptySpace::accept(Player* player, EventList& events)
+{
+  if (player->inventoryFull())
+  {
+    return;
+  }
+
+  if (defaultSymbol == ROCK && player->hasItem(PICK))
+  {
+    player->addItem(ROCK); // add rock to inventory
+    defaultSymbol = EMPTY; // remove rock from space
+
+    Event mined = { Event::ROCKS_MINED, 0 };
+    events.push_back(mined);
+  }
+  else if (defaultSymbol == PICK)
+  {
+    player->addItem(PICK); // add pick to inventory
+    defaultSymbol = EMPTY; // remove pick from space
+
+    Event taken = { Event::PICK_TAKEN, 0 };
+    events.push_back(taken);
   }
 }
 
@@ -0,0 +1,484 @@
+/*********************************************************************
+** Program name: endlessBoard.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: A board for an endless cave. Only a square of chunks around the
+** player is kept as linked spaces; when the player moves into a neighbouring
+** chunk the view scrolls, creating the chunks coming into view and deleting
+** the ones falling out of it. Chunks the player changed are remembered as a
+** short list of differences, up to a fixed limit.
+*********************************************************************/
+
+#include "endlessBoard.hpp"
+#include "space.hpp"
+#include "symbols.hpp"
+#include "bytes.hpp"
+#include "memoryStats.hpp"
+#include "trace.hpp"
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  // Returns true if diff is a valid list of changes to a chunk of cells
+  // spaces: (index, symbol) pairs, where the rules can only empty a space
+  bool validDiff(const std::string& diff, int cells)
+  {
+    if (diff.length() % 2 != 0)
+    {
+      return false;
+    }
+    for (int i = 0, n = diff.length(); i < n; i += 2)
+    {
+      if (static_cast<unsigned char>(diff[i]) >= cells || diff[i + 1] != EMPTY)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+// --- Constructor ---
+// Loads the chunks around chunk [0,0] and puts the player at [1,1] of it
+EndlessBoard::EndlessBoard(unsigned long long seed)
+  : Board(VIEW_CHUNKS * CHUNK_SIZE, VIEW_CHUNKS * CHUNK_SIZE),
+    chunks(seed, CHUNK_SIZE)
+{
+  window.assign(boardRows * boardCols, nullptr);
+  generated.assign(VIEW_CHUNKS * VIEW_CHUNKS, "");
+
+  firstChunkRow = -(VIEW_CHUNKS / 2);
+  firstChunkCol = -(VIEW_CHUNKS / 2);
+
+  for (int i = 0; i < VIEW_CHUNKS; i++)
+  {
+    for (int j = 0; j < VIEW_CHUNKS; j++)
+    {
+      loadChunk(i, j);
+    }
+  }
+  link();
+
+  playerRow = (VIEW_CHUNKS / 2) * CHUNK_SIZE + 1;
+  playerCol = (VIEW_CHUNKS / 2) * CHUNK_SIZE + 1;
+  playerSpace = window[playerRow * boardCols + playerCol];
+  playerSpace->setPlayer(true);
+
+  prefetch();
+}
+
+// --- Destructor ---
+// Spaces in view are deleted by ~Board, which follows the links from origin
+EndlessBoard::~EndlessBoard()
+{
+  forgetAllSaved();
+}
+
+// --- playerMove ---
+// Moves the player as on a normal board, then scrolls the view if the player
+// has left the center chunk
+bool EndlessBoard::playerMove(Space::Direction direction)
+{
+  if (!Board::playerMove(direction))
+  {
+    return false;
+  }
+
+  switch (direction)
+  {
+    case Space::UP:
+      playerRow--;
+      break;
+    case Space::DOWN:
+      playerRow++;
+      break;
+    case Space::LEFT:
+      playerCol--;
+      break;
+    case Space::RIGHT:
+      playerCol++;
+      break;
+  }
+
+  int center = VIEW_CHUNKS / 2;
+  int rowChange = playerRow / CHUNK_SIZE - center;
+  int colChange = playerCol / CHUNK_SIZE - center;
+  if (rowChange != 0 || colChange != 0)
+  {
+    scroll(rowChange, colChange);
+  }
+
+  return true;
+}
+
+// --- loadChunk ---
+// Creates the spaces of the chunk at the given position in view, applying any
+// changes saved when the player last left it
+void EndlessBoard::loadChunk(int slotRow, int slotCol)
+{
+  Trace::Scope scope("load chunk", "load");
+  ChunkCache::Key key(firstChunkRow + slotRow, firstChunkCol + slotCol);
+  std::map<ChunkCache::Key, std::string>::iterator changes = saved.find(key);
+  buildChunk(slotRow, slotCol,
+             changes != saved.end() ? changes->second : std::string());
+}
+
+// --- buildChunk ---
+// Creates the spaces of the chunk at the given position in view with the
+// changes in diff applied
+void EndlessBoard::buildChunk(int slotRow, int slotCol, const std::string& diff)
+{
+  ChunkCache::Key key(firstChunkRow + slotRow, firstChunkCol + slotCol);
+  std::string chunk = chunks.take(key);
+  generated[slotRow * VIEW_CHUNKS + slotCol] = chunk;
+
+  for (int i = 0, n = diff.length(); i + 1 < n; i += 2)
+  {
+    chunk[static_cast<unsigned char>(diff[i])] = diff[i + 1];
+  }
+
+  for (int i = 0; i < CHUNK_SIZE; i++)
+  {
+    for (int j = 0; j < CHUNK_SIZE; j++)
+    {
+      int row = slotRow * CHUNK_SIZE + i;
+      int col = slotCol * CHUNK_SIZE + j;
+      window[row * boardCols + col] = createSpace(chunk[i * CHUNK_SIZE + j]);
+    }
+  }
+}
+
+// --- chunkDiff ---
+// Returns the spaces of the chunk at the given position in view that differ
+// from the generated chunk, as (index, symbol) pairs
+std::string EndlessBoard::chunkDiff(int slotRow, int slotCol)
+{
+  const std::string& chunk = generated[slotRow * VIEW_CHUNKS + slotCol];
+  std::string diff;
+
+  for (int i = 0; i < CHUNK_SIZE; i++)
+  {
+    for (int j = 0; j < CHUNK_SIZE; j++)
+    {
+      int row = slotRow * CHUNK_SIZE + i;
+      int col = slotCol * CHUNK_SIZE + j;
+      char symbol = window[row * boardCols + col]->getDefaultSymbol();
+      if (symbol != chunk[i * CHUNK_SIZE + j])
+      {
+        diff += static_cast<char>(i * CHUNK_SIZE + j);
+        diff += symbol;
+      }
+    }
+  }
+  return diff;
+}
+
+// --- unloadChunk ---
+// Deletes the spaces of the chunk at the given position in view, first saving
+// any spaces that differ from the generated chunk
+void EndlessBoard::unloadChunk(int slotRow, int slotCol)
+{
+  ChunkCache::Key key(firstChunkRow + slotRow, firstChunkCol + slotCol);
+  std::string diff = chunkDiff(slotRow, slotCol);
+
+  for (int i = 0; i < CHUNK_SIZE; i++)
+  {
+    for (int j = 0; j < CHUNK_SIZE; j++)
+    {
+      int row = slotRow * CHUNK_SIZE + i;
+      int col = slotCol * CHUNK_SIZE + j;
+      delete window[row * boardCols + col];
+      window[row * boardCols + col] = nullptr;
+    }
+  }
+
+  savedOrder.remove(key);
+  forgetSaved(key);
+  if (diff.empty())
+  {
+    return;
+  }
+
+  saved[key] = diff;
+  MemoryStats::add(MemoryStats::CACHES, MemoryStats::stringBytes(saved[key]));
+  savedOrder.push_front(key);
+  if (static_cast<int>(saved.size()) > MAX_SAVED_CHUNKS)
+  {
+    forgetSaved(savedOrder.back()); // forget the oldest changes
+    savedOrder.pop_back();
+  }
+}
+
+// --- forgetSaved ---
+// Erases the changes saved for the chunk at key, if there are any
+void EndlessBoard::forgetSaved(ChunkCache::Key key)
+{
+  std::map<ChunkCache::Key, std::string>::iterator found = saved.find(key);
+  if (found != saved.end())
+  {
+    MemoryStats::remove(MemoryStats::CACHES,
+                        MemoryStats::stringBytes(found->second));
+    saved.erase(found);
+  }
+}
+
+// --- forgetAllSaved ---
+// Erases the changes saved for every chunk
+void EndlessBoard::forgetAllSaved()
+{
+  while (!savedOrder.empty())
+  {
+    forgetSaved(savedOrder.back());
+    savedOrder.pop_back();
+  }
+}
+
+// --- scroll ---
+// Moves the view by the given number of chunks (-1, 0 or 1 in each direction),
+// keeping the chunks that stay in view and replacing the rest
+void EndlessBoard::scroll(int rowChange, int colChange)
+{
+  // Unload chunks that are leaving the view
+  for (int i = 0; i < VIEW_CHUNKS; i++)
+  {
+    for (int j = 0; j < VIEW_CHUNKS; j++)
+    {
+      int newRow = i - rowChange;
+      int newCol = j - colChange;
+      if (newRow < 0 || newRow >= VIEW_CHUNKS || newCol < 0 ||
+          newCol >= VIEW_CHUNKS)
+      {
+        unloadChunk(i, j);
+      }
+    }
+  }
+
+  // Shift the remaining spaces and generated maps to their new positions
+  std::vector<Space*> shifted(window.size(), nullptr);
+  for (int row = 0; row < boardRows; row++)
+  {
+    for (int col = 0; col < boardCols; col++)
+    {
+      int newRow = row - rowChange * CHUNK_SIZE;
+      int newCol = col - colChange * CHUNK_SIZE;
+      if (newRow >= 0 && newRow < boardRows && newCol >= 0 &&
+          newCol < boardCols)
+      {
+        shifted[newRow * boardCols + newCol] = window[row * boardCols + col];
+      }
+    }
+  }
+  window.swap(shifted);
+
+  std::vector<std::string> shiftedChunks(generated.size());
+  for (int i = 0; i < VIEW_CHUNKS; i++)
+  {
+    for (int j = 0; j < VIEW_CHUNKS; j++)
+    {
+      int newRow = i - rowChange;
+      int newCol = j - colChange;
+      if (newRow >= 0 && newRow < VIEW_CHUNKS && newCol >= 0 &&
+          newCol < VIEW_CHUNKS)
+      {
+        shiftedChunks[newRow * VIEW_CHUNKS + newCol].swap(
+          generated[i * VIEW_CHUNKS + j]);
+      }
+    }
+  }
+  generated.swap(shiftedChunks);
+
+  firstChunkRow += rowChange;
+  firstChunkCol += colChange;
+  playerRow -= rowChange * CHUNK_SIZE;
+  playerCol -= colChange * CHUNK_SIZE;
+
+  // Load chunks coming into view
+  for (int i = 0; i < VIEW_CHUNKS; i++)
+  {
+    for (int j = 0; j < VIEW_CHUNKS; j++)
+    {
+      if (window[i * CHUNK_SIZE * boardCols + j * CHUNK_SIZE] == nullptr)
+      {
+        loadChunk(i, j);
+      }
+    }
+  }
+
+  link();
+  prefetch();
+}
+
+// --- link ---
+// Links every space in view to its neighbours; spaces at the edge of the view
+// have no neighbour beyond it
+void EndlessBoard::link()
+{
+  for (int row = 0; row < boardRows; row++)
+  {
+    for (int col = 0; col < boardCols; col++)
+    {
+      Space* current = window[row * boardCols + col];
+      current->setAdjacent(Space::UP,
+        row > 0 ? window[(row - 1) * boardCols + col] : nullptr);
+      current->setAdjacent(Space::DOWN,
+        row < boardRows - 1 ? window[(row + 1) * boardCols + col] : nullptr);
+      current->setAdjacent(Space::LEFT,
+        col > 0 ? window[row * boardCols + col - 1] : nullptr);
+      current->setAdjacent(Space::RIGHT,
+        col < boardCols - 1 ? window[row * boardCols + col + 1] : nullptr);
+    }
+  }
+
+  origin = window[0];
+}
+
+// --- prefetch ---
+// Requests the ring of chunks just outside the view, which are the ones the
+// next scroll can bring into view, and forgets any further away
+void EndlessBoard::prefetch()
+{
+  int center = VIEW_CHUNKS / 2;
+  ChunkCache::Key middle(firstChunkRow + center, firstChunkCol + center);
+  int radius = center + 1;
+
+  for (int i = -radius; i <= radius; i++)
+  {
+    for (int j = -radius; j <= radius; j++)
+    {
+      if (i == -radius || i == radius || j == -radius || j == radius)
+      {
+        chunks.prefetch(ChunkCache::Key(middle.first + i, middle.second + j));
+      }
+    }
+  }
+
+  chunks.retain(middle, radius);
+}
+
+// --- saveState ---
+// Appends the position of the view and the player, the changes remembered for
+// chunks out of view (most recent first) and the changes to each chunk in
+// view to out. Changes are found by comparing chunks with the cave, so
+// changed is not used.
+void EndlessBoard::saveState(std::string& out,
+                             const std::vector<std::pair<Space*, char> >& changed)
+{
+  Bytes::putInt(out, static_cast<unsigned long long>(firstChunkRow), 8);
+  Bytes::putInt(out, static_cast<unsigned long long>(firstChunkCol), 8);
+  Bytes::putInt(out, playerRow, 4);
+  Bytes::putInt(out, playerCol, 4);
+
+  Bytes::putInt(out, savedOrder.size(), 4);
+  for (std::list<ChunkCache::Key>::iterator i = savedOrder.begin();
+       i != savedOrder.end(); i++)
+  {
+    Bytes::putInt(out, static_cast<unsigned long long>(i->first), 8);
+    Bytes::putInt(out, static_cast<unsigned long long>(i->second), 8);
+    Bytes::putString(out, saved[*i]);
+  }
+
+  for (int i = 0; i < VIEW_CHUNKS; i++)
+  {
+    for (int j = 0; j < VIEW_CHUNKS; j++)
+    {
+      Bytes::putString(out, chunkDiff(i, j));
+    }
+  }
+}
+
+// --- loadState ---
+// Reads a state written by saveState from in at pos and rebuilds the view
+// from it. changed is left empty, since endless caves are never reset.
+// Returns false, changing nothing, if the state is not valid.
+bool EndlessBoard::loadState(const std::string& in, std::size_t& pos,
+                             std::vector<std::pair<Space*, char> >& changed)
+{
+  std::size_t start = pos;
+  unsigned long long chunkRow = 0;
+  unsigned long long chunkCol = 0;
+  unsigned long long row = 0;
+  unsigned long long col = 0;
+  unsigned long long savedCount = 0;
+  bool valid = Bytes::getInt(in, pos, 8, chunkRow) &&
+               Bytes::getInt(in, pos, 8, chunkCol) &&
+               Bytes::getInt(in, pos, 4, row) &&
+               Bytes::getInt(in, pos, 4, col) &&
+               Bytes::getInt(in, pos, 4, savedCount) &&
+               row < static_cast<unsigned long long>(boardRows) &&
+               col < static_cast<unsigned long long>(boardCols) &&
+               savedCount <= MAX_SAVED_CHUNKS;
+
+  std::map<ChunkCache::Key, std::string> newSaved;
+  std::list<ChunkCache::Key> newOrder;
+  for (unsigned long long i = 0; valid && i < savedCount; i++)
+  {
+    unsigned long long keyRow = 0;
+    unsigned long long keyCol = 0;
+    std::string diff;
+    valid = Bytes::getInt(in, pos, 8, keyRow) &&
+            Bytes::getInt(in, pos, 8, keyCol) &&
+            Bytes::getString(in, pos, diff) &&
+            validDiff(diff, CHUNK_SIZE * CHUNK_SIZE);
+    if (!valid)
+    {
+      break;
+    }
+
+    ChunkCache::Key key(static_cast<long long>(keyRow),
+                        static_cast<long long>(keyCol));
+    valid = newSaved.insert(std::make_pair(key, diff)).second;
+    newOrder.push_back(key);
+  }
+
+  std::vector<std::string> diffs(VIEW_CHUNKS * VIEW_CHUNKS);
+  for (int i = 0; valid && i < VIEW_CHUNKS * VIEW_CHUNKS; i++)
+  {
+    valid = Bytes::getString(in, pos, diffs[i]) &&
+            validDiff(diffs[i], CHUNK_SIZE * CHUNK_SIZE);
+  }
+
+  if (!valid)
+  {
+    pos = start;
+    return false;
+  }
+
+  // Replace every chunk in view
+  changed.clear();
+  for (int i = 0, n = window.size(); i < n; i++)
+  {
+    delete window[i];
+    window[i] = nullptr;
+  }
+
+  forgetAllSaved();
+  saved.swap(newSaved);
+  savedOrder.swap(newOrder);
+  for (std::map<ChunkCache::Key, std::string>::iterator i = saved.begin();
+       i != saved.end(); i++)
+  {
+    MemoryStats::add(MemoryStats::CACHES, MemoryStats::stringBytes(i->second));
+  }
+  firstChunkRow = static_cast<long long>(chunkRow);
+  firstChunkCol = static_cast<long long>(chunkCol);
+  playerRow = row;
+  playerCol = col;
+
+  for (int i = 0; i < VIEW_CHUNKS; i++)
+  {
+    for (int j = 0; j < VIEW_CHUNKS; j++)
+    {
+      buildChunk(i, j, diffs[i * VIEW_CHUNKS + j]);
+    }
+  }
+  link();
+
+  playerSpace = window[playerRow * boardCols + playerCol];
+  playerSpace->setPlayer(true);
+
+  prefetch();
+  return true;
+}
@@ -0,0 +1,67 @@
+/*********************************************************************
+** Program name: endlessBoard.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: A board for an endless cave. Only a square of chunks around the
+** player is kept as linked spaces; when the player moves into a neighbouring
+** chunk the view scrolls, creating the chunks coming into view and deleting
+** the ones falling out of it. Chunks the player changed are remembered as a
+** short list of differences, up to a fixed limit.
+*********************************************************************/
+
+#ifndef ENDLESSBOARD_HPP
+#define ENDLESSBOARD_HPP
+
+#include "board.hpp"
+#include "chunkCache.hpp"
+#include "space.hpp"
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+class EndlessBoard : public Board
+{
+private:
+  static const int CHUNK_SIZE = 8; // rows and columns of spaces per chunk
+  static const int VIEW_CHUNKS = 3; // rows and columns of chunks in view
+  static const int MAX_SAVED_CHUNKS = 64; // changed chunks remembered
+
+  ChunkCache chunks;
+
+  std::vector<Space*> window; // spaces in view, row by row
+  std::vector<std::string> generated; // generated map of each chunk in view
+  long long firstChunkRow; // position of the top left chunk in view
+  long long firstChunkCol;
+  int playerRow; // player's position within the view
+  int playerCol;
+
+  // Changes made to chunks that have scrolled out of view, stored as
+  // (index, symbol) pairs; least recently saved chunks are forgotten first
+  std::map<ChunkCache::Key, std::string> saved;
+  std::list<ChunkCache::Key> savedOrder;
+
+  void loadChunk(int slotRow, int slotCol);
+  void buildChunk(int slotRow, int slotCol, const std::string& diff);
+  std::string chunkDiff(int slotRow, int slotCol);
+  void unloadChunk(int slotRow, int slotCol);
+  void forgetSaved(ChunkCache::Key key);
+  void forgetAllSaved();
+  void scroll(int rowChange, int colChange);
+  void link();
+  void prefetch();
+
+public:
+  EndlessBoard(unsigned long long seed);
+  virtual ~EndlessBoard();
+
+  using Board::playerMove;
+  virtual bool playerMove(Space::Direction direction);
+
+  virtual void saveState(std::string& out,
+                         const std::vector<std::pair<Space*, char> >& changed);
+  virtual bool loadState(const std::string& in, std::size_t& pos,
+                         std::vector<std::pair<Space*, char> >& changed);
+};
+
+#endif
@@ -0,0 +1,43 @@
+/*********************************************************************
+** Program name: event.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Something that happened during a turn, reported by the game
+** rules instead of being printed. Front ends decide how (or whether) to show
+** each event to the player.
+*********************************************************************/
+
+#ifndef EVENT_HPP
+#define EVENT_HPP
+
+#include <vector>
+
+struct Event
+{
+  enum Type
+  {
+    NOTHING_FOUND, // inspected an empty space
+    ROCKS_FOUND, // inspected a space with rocks
+    PICK_FOUND, // inspected a space with a pickaxe
+    HAVE_PICK, // can mine the rocks with the pickaxe carried
+    HAVE_PICK_FULL, // carrying a pickaxe, but no room for rocks
+    ROCKS_MINED,
+    PICK_TAKEN,
+    HOLE_FILLED,
+    FELL_IN_HOLE,
+    EXIT_REACHED,
+    PASSAGE_FOUND, // reached an exit in an endless cave
+    SEGMENT_REACHED, // value is the new segment number
+    OUT_OF_STEPS,
+    INVENTORY, // player asked to see their inventory
+    QUIT,
+    BLOCKED // another player in the shared cave is on the space moved to
+  };
+
+  Type type;
+  int value;
+};
+
+typedef std::vector<Event> EventList;
+
+#endif
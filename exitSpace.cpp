@@ -9,7 +9,8 @@
 #include "exitSpace.hpp"
 #include "player.hpp"
 #include "symbols.hpp"
-#include <iostream>
+#include "memoryStats.hpp"
+#include <cstddef>
 
 // --- Constructor ---
 ExitSpace::ExitSpace()
@@ -24,17 +25,48 @@ ExitSpace::~ExitSpace()
 {
 }
 
+// --- operator new ---
+void* ExitSpace::operator new(std::size_t size)
+{
+  return MemoryStats::allocate(MemoryStats::EXIT_SPACES, size);
+}
+
+// --- operator delete ---
+void ExitSpace::operator delete(void* pointer, std::size_t size)
+{
+  MemoryStats::release(MemoryStats::EXIT_SPACES, pointer, size);
+}
+
 // --- arrive ---
-// Executes upon player arriving in a space;
-// does nothing for an empty space
-void ExitSpace::arrive(Player* player)
+// Executes upon player arriving in a space; in an endless cave the exit leads
+// to the next segment and collapses behind the player, otherwise the player
+// wins
+void ExitSpace::arrive(Player* player, EventList& events)
 {
-  std::cout << "You reached the exit!\n";
+  if (defaultSymbol != EXIT)
+  {
+    return; // passage has already been used
+  }
+
+  if (player->isEndless())
+  {
+    player->advanceSegment();
+    defaultSymbol = EMPTY;
+
+    Event passage = { Event::PASSAGE_FOUND, 0 };
+    events.push_back(passage);
+    return;
+  }
+
   player->setState(Player::WIN);
+
+  Event reached = { Event::EXIT_REACHED, 0 };
+  events.push_back(reached);
 }
 
 // --- inspect ---
 // Executes upon player choosing to inspect current space
-void ExitSpace::inspect(Player* player)
+Space::Offer ExitSpace::inspect(Player* player, EventList& events)
 {
+  return NO_OFFER;
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 
 #include "space.hpp"
 #include "player.hpp"
+#include <cstddef>
 
 class ExitSpace : public Space
 {
@@ -19,8 +20,13 @@ private:
 public:
   ExitSpace();
   virtual ~ExitSpace();
-  virtual void arrive(Player* player);
-  virtual void inspect(Player* player);
+
+  // Counted in MemoryStats
+  static void* operator new(std::size_t size);
+  static void operator delete(void* pointer, std::size_t size);
+
+  virtual void arrive(Player* player, EventList& events);
+  virtual Offer inspect(Player* player, EventList& events);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,157 @@
+/*********************************************************************
+** Program name: fixedBoard.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: A map of a size fixed at compile time, for searching small
+** levels quickly. The symbols are kept in an array inside the object, and the
+** walls of each row in one 64-bit word, so checking a move is a shift and a
+** mask and finding a cell's row and column divides by a constant. A flood
+** fill moves a whole row of the frontier at once with the same words. Maps
+** up to 64 columns wide fit; LevelSolver uses one whenever a map matches one
+** of the sizes it is built for, and a board sized at run time otherwise.
+*********************************************************************/
+
+#ifndef FIXEDBOARD_HPP
+#define FIXEDBOARD_HPP
+
+#include "symbols.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+template <int Rows, int Cols>
+class FixedBoard
+{
+  static_assert(Rows >= 2 && Cols >= 2, "the player starts at [1,1]");
+  static_assert(Cols <= 64, "a row of walls must fit in one 64-bit word");
+
+public:
+  static const int CELLS = Rows * Cols;
+
+private:
+  // Bits of a whole row
+  static const std::uint64_t ROW = Cols == 64 ? ~0ULL : (1ULL << Cols % 64) - 1;
+
+  char tiles[CELLS];
+  std::uint64_t walls[Rows]; // bit col of walls[row] is set for a wall
+  std::uint64_t safe[Rows]; // spaces that are neither walls nor holes
+  std::uint64_t exits[Rows];
+
+  bool isWall(int row, int col) const;
+
+public:
+  FixedBoard(const std::string& map);
+
+  char symbol(int cell) const;
+  int move(int cell, char direction) const;
+  bool exitWithin(int cell, int maxSteps) const;
+};
+
+// --- Constructor ---
+// Takes a map of Rows * Cols symbols in the row-major format Board::readMap
+// produces
+template <int Rows, int Cols>
+FixedBoard<Rows, Cols>::FixedBoard(const std::string& map)
+{
+  map.copy(tiles, CELLS);
+  for (int row = 0; row < Rows; row++)
+  {
+    std::uint64_t wallRow = 0;
+    std::uint64_t holeRow = 0;
+    std::uint64_t exitRow = 0;
+    for (int col = 0; col < Cols; col++)
+    {
+      char type = tiles[row * Cols + col];
+      wallRow |= static_cast<std::uint64_t>(type == WALL) << col;
+      holeRow |= static_cast<std::uint64_t>(type == HOLE) << col;
+      exitRow |= static_cast<std::uint64_t>(type == EXIT) << col;
+    }
+    walls[row] = wallRow;
+    safe[row] = ~(wallRow | holeRow) & ROW;
+    exits[row] = exitRow;
+  }
+}
+
+// --- isWall ---
+template <int Rows, int Cols>
+inline bool FixedBoard<Rows, Cols>::isWall(int row, int col) const
+{
+  return walls[row] >> col & 1;
+}
+
+// --- symbol ---
+template <int Rows, int Cols>
+inline char FixedBoard<Rows, Cols>::symbol(int cell) const
+{
+  return tiles[cell];
+}
+
+// --- move ---
+// Returns the cell reached by moving one space in direction (W, A, S or D)
+// from cell, or -1 if the edge of the map or a wall is in the way
+template <int Rows, int Cols>
+inline int FixedBoard<Rows, Cols>::move(int cell, char direction) const
+{
+  int row = cell / Cols;
+  int col = cell % Cols;
+
+  switch (direction)
+  {
+    case 'W':
+      return row > 0 && !isWall(row - 1, col) ? cell - Cols : -1;
+    case 'A':
+      return col > 0 && !isWall(row, col - 1) ? cell - 1 : -1;
+    case 'S':
+      return row < Rows - 1 && !isWall(row + 1, col) ? cell + Cols : -1;
+    case 'D':
+      return col < Cols - 1 && !isWall(row, col + 1) ? cell + 1 : -1;
+  }
+  return -1;
+}
+
+// --- exitWithin ---
+// Returns true if an exit can be reached from cell in at most maxSteps moves
+// without entering a wall or a hole. Spreads one move from every space
+// reached so far at a time, a row per word.
+template <int Rows, int Cols>
+bool FixedBoard<Rows, Cols>::exitWithin(int cell, int maxSteps) const
+{
+  std::uint64_t reached[Rows] = {};
+  reached[cell / Cols] = 1ULL << cell % Cols;
+  if (reached[cell / Cols] & exits[cell / Cols])
+  {
+    return true;
+  }
+
+  for (int steps = 1; steps <= maxSteps; steps++)
+  {
+    std::uint64_t next[Rows];
+    bool grew = false;
+    for (int row = 0; row < Rows; row++)
+    {
+      std::uint64_t spread = reached[row] << 1 | reached[row] >> 1;
+      if (row > 0)
+      {
+        spread |= reached[row - 1];
+      }
+      if (row < Rows - 1)
+      {
+        spread |= reached[row + 1];
+      }
+      next[row] = reached[row] | (spread & safe[row]);
+      if (next[row] & exits[row])
+      {
+        return true;
+      }
+      grew = grew || next[row] != reached[row];
+    }
+    if (!grew)
+    {
+      return false; // every space within reach has been reached
+    }
+    std::copy(next, next + Rows, reached);
+  }
+  return false;
+}
+
+#endif
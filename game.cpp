@@ -2,19 +2,52 @@
 ** Program name: game.cpp
 ** Author: Jesse McKenna
 ** Date: 12/5/2017
-** Description: Contains the game board and player object, and manages
-** interactions between them
+** Description: Console front end for the game; reads the player's input,
+** passes it to the game rules in GameState, and prints what happened
 *********************************************************************/
 
 #include "game.hpp"
 #include "board.hpp"
+#include "endlessBoard.hpp"
+#include "gameState.hpp"
 #include "player.hpp"
+#include "menu.hpp"
 #include "getInput.hpp"
+#include "mctsAgent.hpp"
+#include "replay.hpp"
+#include "savedGame.hpp"
+#include "leaderboard.hpp"
+#include "messages.hpp"
+#include "turnStats.hpp"
+#include "trace.hpp"
+#include <ctime>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  const int AUTOPLAY_MILLISECONDS = 500; // thinking time per computer action
+  const char SAVE_FILENAME[] = "cave.save";
+  const int LEADERS_SHOWN = 5; // wins listed after winning on the map
+
+  const char* ACTION_NAMES[] = { "move up", "move down", "move left",
+                                 "move right", "inspect", "inventory", "quit",
+                                 "accept", "decline", "undo", "redo" };
+}
 
 // --- Constructor ---
 Game::Game()
 {
+  endless = false;
+  seed = 0;
+  autoplay = false;
+  continuing = false;
+  leaderboard = nullptr;
+  stats = nullptr;
 }
 
 // --- Destructor ---
@@ -22,71 +55,378 @@ Game::~Game()
 {
 }
 
+// --- setEndless ---
+// Chooses between the map (false) and an endless cave generated from caveSeed
+// (true) for the following games
+void Game::setEndless(bool status, unsigned long long caveSeed)
+{
+  endless = status;
+  seed = caveSeed;
+}
+
+// --- setAutoplay ---
+// Chooses whether the computer plays the following games; the endless cave is
+// always played by the user
+void Game::setAutoplay(bool status)
+{
+  autoplay = status;
+}
+
+// --- setRecording ---
+// Records a replay of each following game to filename, replacing the last
+// game's; an empty filename stops recording
+void Game::setRecording(const std::string& filename)
+{
+  replayFilename = filename;
+}
+
+// --- setLeaderboard ---
+// Ranks the user's wins on the map on board, which must outlive the game,
+// under name; a null board stops ranking them
+void Game::setLeaderboard(Leaderboard* board, const std::string& name)
+{
+  leaderboard = board;
+  playerName = name;
+}
+
+// --- setStats ---
+// Measures the following games' turns in turnStats, which must outlive the
+// game; null stops measuring them
+void Game::setStats(TurnStats* turnStats)
+{
+  stats = turnStats;
+}
+
+// --- continueSavedGame ---
+// Sets up the next game to carry on from the saved game, if there is one;
+// returns false if there is not
+bool Game::continueSavedGame()
+{
+  SavedGame::Info info;
+  if (!SavedGame::readInfo(SAVE_FILENAME, info))
+  {
+    return false;
+  }
+
+  setEndless(info.endless, info.seed);
+  continuing = true;
+  return true;
+}
+
+// --- readAction ---
+// Shows the controls and returns the action for the key the user enters; the
+// endless cave cannot be undone
+GameState::Action Game::readAction()
+{
+  printControls(std::cout, !endless);
+  char input = getChar(endless ? "WASDwasdEeIiQq" : "WASDwasdEeIiQqUuRr");
+
+  if (input == 'Q' || input == 'q')
+  {
+    return GameState::QUIT;
+  }
+  else if (input == 'E' || input == 'e') // inspect current space
+  {
+    return GameState::INSPECT;
+  }
+  else if (input == 'I' || input == 'i')
+  {
+    return GameState::INVENTORY;
+  }
+  else if (input == 'U' || input == 'u')
+  {
+    return GameState::UNDO;
+  }
+  else if (input == 'R' || input == 'r')
+  {
+    return GameState::REDO;
+  }
+  else if (input == 'W' || input == 'w')
+  {
+    return GameState::MOVE_UP;
+  }
+  else if (input == 'A' || input == 'a')
+  {
+    return GameState::MOVE_LEFT;
+  }
+  else if (input == 'S' || input == 's')
+  {
+    return GameState::MOVE_DOWN;
+  }
+  return GameState::MOVE_RIGHT;
+}
+
+// --- answerOffer ---
+// Shows a menu for an offer made on inspecting a space; returns true if the
+// user accepts it
+bool Game::answerOffer(Space::Offer offer)
+{
+  Menu offerMenu(2);
+  if (offer == Space::MINE_ROCKS)
+  {
+    offerMenu.setPrompt(1, "Mine the rocks");
+  }
+  else
+  {
+    offerMenu.setPrompt(1, "Take the pickaxe");
+  }
+  offerMenu.setPrompt(2, "Do nothing");
+
+  return offerMenu.showMenu() == 1;
+}
+
+// --- offerSave ---
+// Asks the user whether to save the game they are quitting, and saves it if
+// they want to
+void Game::offerSave(GameState& state)
+{
+  Menu saveMenu(2);
+  saveMenu.setPrompt(1, "Save the game and quit");
+  saveMenu.setPrompt(2, "Quit without saving");
+  if (saveMenu.showMenu() != 1)
+  {
+    return;
+  }
+
+  if (SavedGame::save(SAVE_FILENAME, state, seed))
+  {
+    std::cout << "Game saved.\n";
+  }
+  else
+  {
+    std::cout << "Could not write " << SAVE_FILENAME << "\n";
+  }
+}
+
+// --- chooseAction ---
+// Asks the computer player for its next action, shows it along with how hard
+// the computer searched, and moves the computer's copies of the game along
+GameState::Action Game::chooseAction(MctsAgent& agent)
+{
+  GameState::Action action = agent.chooseAction();
+  std::cout << "\nComputer chooses: " << ACTION_NAMES[action] << " ("
+            << agent.getIterations() << " playouts, " << std::fixed
+            << std::setprecision(0) << agent.getIterationsPerSecond()
+            << "/sec)\n";
+  agent.advance(action);
+  return action;
+}
+
+// --- recordWin ---
+// Adds the user's win in state to the leaderboard and shows where it ranks
+// along with the best wins on the map. If the game was recorded in replay,
+// the replay is kept under a name of its own as proof of the win.
+void Game::recordWin(GameState& state, Replay& replay)
+{
+  Leaderboard::Entry entry;
+  entry.mapHash = Board::hashMap(state.getBoard()->getMap());
+  entry.steps = GameState::START_STEPS - state.getSteps();
+  entry.name = playerName;
+  entry.time = std::time(nullptr);
+  if (!replayFilename.empty())
+  {
+    entry.replay = replayFilename + "." + std::to_string(entry.time);
+    if (!replay.save(entry.replay))
+    {
+      std::cout << "Could not write " << entry.replay << "\n";
+      entry.replay.clear();
+    }
+  }
+
+  if (!leaderboard->add(entry) || !leaderboard->flush())
+  {
+    std::cout << "Could not record your win on the leaderboard.\n";
+    return;
+  }
+
+  std::cout << "\nYou escaped in " << entry.steps << " steps, rank "
+            << leaderboard->getRankOf(entry.mapHash, entry.steps) << " of "
+            << leaderboard->getPlayers(entry.mapHash) << " on this map.\n";
+  std::vector<Leaderboard::Entry> top =
+    leaderboard->getTop(entry.mapHash, LEADERS_SHOWN);
+  for (int i = 0, n = top.size(); i < n; i++)
+  {
+    std::cout << std::setw(3) << leaderboard->getRankOf(entry.mapHash,
+                                                        top[i].steps)
+              << ". " << top[i].name << ", " << top[i].steps << " steps\n";
+  }
+}
+
 // --- play ---
 // Runs the game
 void Game::play()
 {
-  Board board;
-  int steps = START_STEPS;
-  player = new Player;
-  player->setState(Player::PLAYING);
+  Board* board;
+  if (endless)
+  {
+    board = new EndlessBoard(seed);
+  }
+  else
+  {
+    board = new Board;
+  }
 
-  std::cout << "You (X) are trapped in a cave.\n"
-            << "Make it to the exit (E) before you run out of steps,\n"
-            << "but be careful not to fall down any holes (@)!\n\n";
+  GameState state(board, endless);
+  Player* player = state.getPlayer();
 
-  do
+  bool loaded = false;
+  if (continuing)
+  {
+    continuing = false; // only the first game carries on from the save
+    loaded = SavedGame::load(SAVE_FILENAME, state);
+    if (!loaded)
+    {
+      std::cout << "The saved game is for a different map; starting a new "
+                << "game.\n\n";
+    }
+  }
+
+  // The computer searches its own copies of the map
+  bool computer = autoplay && !endless;
+  std::unique_ptr<MctsAgent> agent;
+  if (computer)
+  {
+    MctsAgent::Settings settings;
+    settings.iterations = 0;
+    settings.milliseconds = AUTOPLAY_MILLISECONDS;
+    settings.threads = std::thread::hardware_concurrency();
+    settings.seed = std::time(nullptr);
+    agent.reset(new MctsAgent(board->getMap(), board->getRows(),
+                              board->getCols(), settings));
+  }
+
+  Replay replay;
+  if (!replayFilename.empty())
   {
-    std::cout << steps << " steps remaining\n";
+    replay.start(state, seed);
+  }
 
-    board.print();
+  printIntro(std::cout, endless, seed);
+
+  if (loaded)
+  {
+    std::cout << "Carrying on from your saved game.\n\n";
+  }
 
-    // Get user input
-    std::cout << "\n"
-              << "Move:   W       Inspect: E       Inventory: I       Quit: Q\n"
-              << "      A S D\n";
-    char input = getChar("WASDwasdEeIiQq");
+  do
+  {
+    Trace::Scope scope("turn", "game");
+    long long time = stats != nullptr ? TurnStats::now() : 0;
+    std::cout << state.getSteps() << " steps remaining\n";
 
-    if (input == 'Q' || input == 'q')
+    board->print();
+    if (stats != nullptr)
     {
-      player->setState(Player::LOSE);
+      time = stats->mark(TurnStats::RENDER, time);
     }
-    else if (input == 'E' || input == 'e') // inspect current space
+
+    GameState::Action action = computer ? chooseAction(*agent) : readAction();
+    if (action == GameState::QUIT && !computer)
     {
-      board.getPlayerSpace()->inspect(player);
+      offerSave(state);
     }
-    else if (input == 'I' || input == 'i')
+    if (stats != nullptr)
     {
-      player->printInventory();
+      time = stats->mark(TurnStats::INPUT, time);
     }
-    else
+    const GameState::Outcome* outcome = &state.step(action);
+    if (stats != nullptr)
+    {
+      stats->mark(TurnStats::RULES, time);
+      stats->countAction(action, *outcome);
+    }
+    if (!replayFilename.empty())
+    {
+      replay.addAction(action, state);
+    }
+    printEvents(std::cout, player, outcome->events);
+
+    // An inspection and the answer to its offer are undone and redone
+    // together, so the offer is not asked again
+    if (action == GameState::UNDO || action == GameState::REDO)
     {
-      if(board.playerMove(input)) // pass WASD input as direction to move player
+      if (!outcome->valid)
+      {
+        std::cout << (action == GameState::UNDO ? "\nNothing to undo.\n" :
+                                                  "\nNothing to redo.\n");
+      }
+      while (outcome->valid && outcome->offer != Space::NO_OFFER)
       {
-        board.getPlayerSpace()->arrive(player);
-        steps--; // player attempts to move; decrement steps if move successful
+        time = stats != nullptr ? TurnStats::now() : 0;
+        outcome = &state.step(action);
+        if (stats != nullptr)
+        {
+          stats->mark(TurnStats::RULES, time);
+          stats->countAction(action, *outcome);
+        }
+        if (!replayFilename.empty())
+        {
+          replay.addAction(action, state);
+        }
+        printEvents(std::cout, player, outcome->events);
       }
     }
 
-    // Game over if run out of steps
-    if (steps < 0)
+    // Inspecting may offer a choice, which is answered through a menu
+    while (outcome->offer != Space::NO_OFFER)
     {
-      std::cout << "You ran out of steps!\n";
-      player->setState(Player::LOSE);
+      time = stats != nullptr ? TurnStats::now() : 0;
+      if (computer)
+      {
+        action = chooseAction(*agent);
+      }
+      else
+      {
+        action = answerOffer(outcome->offer) ? GameState::ACCEPT :
+                                               GameState::DECLINE;
+      }
+      if (stats != nullptr)
+      {
+        time = stats->mark(TurnStats::INPUT, time);
+      }
+      outcome = &state.step(action);
+      if (stats != nullptr)
+      {
+        stats->mark(TurnStats::RULES, time);
+        stats->countAction(action, *outcome);
+      }
+      if (!replayFilename.empty())
+      {
+        replay.addAction(action, state);
+      }
+      printEvents(std::cout, player, outcome->events);
     }
 
   } while (player->getState() == Player::PLAYING);
 
-  // Display win or lose message
-  switch (player->getState())
+  if (stats != nullptr)
+  {
+    stats->countGame(board->getSpacesCreated());
+  }
+
+  printResult(std::cout, player);
+
+  if (!replayFilename.empty())
   {
-    case Player::WIN:
-      std::cout << "You win!\n";
-      break;
-    case Player::LOSE:
-      std::cout << "Game over.\n";
-      break;
+    replay.finish(state);
+    if (!replay.save(replayFilename))
+    {
+      std::cout << "Could not write " << replayFilename << "\n";
+    }
   }
 
-  delete player;
-}
\ No newline at end of file
+  // A saved game's steps come from a file the player can edit, and its replay
+  // does not start from a new game, so such a win could not be checked
+  if (leaderboard != nullptr && player->getState() == Player::WIN &&
+      !computer && !endless)
+  {
+    if (loaded)
+    {
+      std::cout << "\nWins carried on from a saved game are not ranked.\n";
+    }
+    else
+    {
+      recordWin(state, replay);
+    }
+  }
+}
@@ -2,25 +2,49 @@
 ** Program name: game.hpp
 ** Author: Jesse McKenna
 ** Date: 12/5/2017
-** Description: Contains the game board and player object, and manages
-** interactions between them
+** Description: Console front end for the game; reads the player's input,
+** passes it to the game rules in GameState, and prints what happened
 *********************************************************************/
 
 #ifndef GAME_HPP
 #define GAME_HPP
 
-#include "player.hpp"
+#include "gameState.hpp"
+#include <string>
+
+class Leaderboard;
+class MctsAgent;
+class Replay;
+class TurnStats;
 
 class Game
 {
 private:
-  const int START_STEPS = 22;
-  Player* player;
+  bool endless; // play an endless cave instead of the map
+  unsigned long long seed; // seed of the endless cave
+  bool autoplay; // let the computer play instead of reading input
+  std::string replayFilename; // where to record each game; empty for none
+  bool continuing; // load the saved game at the start of the next game
+  Leaderboard* leaderboard; // where wins on the map are ranked; may be null
+  std::string playerName; // the player's name on the leaderboard
+  TurnStats* stats; // where turns are measured; null for no measuring
+
+  GameState::Action readAction();
+  bool answerOffer(Space::Offer offer);
+  void offerSave(GameState& state);
+  GameState::Action chooseAction(MctsAgent& agent);
+  void recordWin(GameState& state, Replay& replay);
 
 public:
   Game();
   ~Game();
+  void setEndless(bool status, unsigned long long caveSeed);
+  void setAutoplay(bool status);
+  void setRecording(const std::string& filename);
+  void setLeaderboard(Leaderboard* board, const std::string& name);
+  void setStats(TurnStats* turnStats);
+  bool continueSavedGame();
   void play();
 };
 
-#endif
\ No newline at end of file
+#endif
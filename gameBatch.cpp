@@ -0,0 +1,311 @@
+/*********************************************************************
+** Program name: gameBatch.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Many independent games of one map stepped together, for
+** training computer players. Instead of a board of linked spaces per game,
+** every game is a handful of numbers kept in one array per field (player
+** cell, steps left, picks, rocks, and a bit per hole filled, rock mined or
+** pick taken), so stepping every game is a few passes over flat arrays.
+** Finished games start over from the map straight away. The rules are a
+** template parameter, so each rule set gets a step loop of its own.
+*********************************************************************/
+
+#include "gameBatch.hpp"
+#include "symbols.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// --- Constructor ---
+// Takes a map in the same row-major format Board::readMap produces and starts
+// count games on it under rules. Maps with more than MAX_TILES holes, rocks
+// and picks, or a wall at the start, cannot be played; see isValid.
+template <typename Rules>
+GameBatch<Rules>::GameBatch(const std::string& map, int rows, int cols,
+                            int count, const Rules& rules)
+  : rules(rules)
+{
+  this->map = map;
+  this->rows = rows;
+  this->cols = cols;
+  this->count = count > 0 ? count : 0;
+  start = cols + 1;
+  episodes = 0;
+  wins = 0;
+
+  int cells = map.length();
+  valid = rows >= 2 && cols >= 2 && cells == rows * cols && map[start] != WALL;
+
+  tileBit.assign(cells, -1);
+  int bits = 0;
+  for (int i = 0; i < cells; i++)
+  {
+    if (map[i] == HOLE || map[i] == ROCK || map[i] == PICK)
+    {
+      tileBit[i] = bits < MAX_TILES ? bits : -1;
+      bits++;
+    }
+  }
+  valid = valid && bits <= MAX_TILES;
+
+  // Where each action leads from each cell; walls and edges leave the player
+  // where they are, and so does TAKE
+  moves.resize(ACTIONS * cells);
+  for (int i = 0; i < cells; i++)
+  {
+    int row = i / cols;
+    int col = i % cols;
+    int targets[] = { row > 0 ? i - cols : -1,
+                      row < rows - 1 ? i + cols : -1,
+                      col > 0 ? i - 1 : -1,
+                      col < cols - 1 ? i + 1 : -1,
+                      i };
+
+    for (int a = 0; a < ACTIONS; a++)
+    {
+      int target = targets[a];
+      moves[a * cells + i] = target >= 0 && map[target] != WALL ? target : i;
+    }
+  }
+
+  cell.resize(this->count);
+  steps.resize(this->count);
+  picks.resize(this->count);
+  rocks.resize(this->count);
+  tiles.resize(this->count);
+  moved.resize(this->count);
+  observations.resize(this->count * OBSERVATION_SIZE);
+  rewards.resize(this->count);
+  done.resize(this->count);
+
+  reset();
+}
+
+// --- tileAt ---
+// Returns the symbol of a space as game sees it now: used-up tiles are empty,
+// and anything off the map is a wall
+template <typename Rules>
+char GameBatch<Rules>::tileAt(int game, int row, int col)
+{
+  if (row < 0 || row >= rows || col < 0 || col >= cols)
+  {
+    return WALL;
+  }
+
+  int i = row * cols + col;
+  int bit = tileBit[i];
+  if (bit >= 0 && (tiles[game] >> bit & 1))
+  {
+    return EMPTY;
+  }
+  return map[i];
+}
+
+// --- resetGame ---
+template <typename Rules>
+void GameBatch<Rules>::resetGame(int game)
+{
+  cell[game] = start;
+  steps[game] = rules.startSteps();
+  picks[game] = 0;
+  rocks[game] = 0;
+  tiles[game] = 0;
+}
+
+// --- observe ---
+// Writes game's observation into the observation buffer
+template <typename Rules>
+void GameBatch<Rules>::observe(int game)
+{
+  std::int32_t* out = &observations[game * OBSERVATION_SIZE];
+  int row = cell[game] / cols;
+  int col = cell[game] % cols;
+
+  out[0] = row;
+  out[1] = col;
+  out[2] = steps[game];
+  out[3] = picks[game];
+  out[4] = rocks[game];
+  for (int i = 0; i < 9; i++)
+  {
+    out[5 + i] = tileAt(game, row - 1 + i / 3, col - 1 + i % 3);
+  }
+}
+
+// --- isValid ---
+// Returns false if the map cannot be played; step does nothing in that case
+template <typename Rules>
+bool GameBatch<Rules>::isValid()
+{
+  return valid;
+}
+
+// --- getCount ---
+template <typename Rules>
+int GameBatch<Rules>::getCount()
+{
+  return count;
+}
+
+// --- reset ---
+// Starts every game over
+template <typename Rules>
+void GameBatch<Rules>::reset()
+{
+  for (int i = 0; i < count; i++)
+  {
+    resetGame(i);
+    rewards[i] = 0;
+    done[i] = 0;
+    if (valid)
+    {
+      observe(i);
+    }
+  }
+}
+
+// --- step ---
+// Carries out actions[i] in game i for every game. Rewards are 1 for a win,
+// -1 for a loss and 0 otherwise; a finished game is flagged as done and
+// started over, so its observation is of the new game. Returns false without
+// changing anything if the map is invalid or an action is out of range.
+template <typename Rules>
+bool GameBatch<Rules>::step(const std::vector<std::uint8_t>& actions)
+{
+  if (!valid || static_cast<int>(actions.size()) != count)
+  {
+    return false;
+  }
+  for (int i = 0; i < count; i++)
+  {
+    if (actions[i] >= ACTIONS)
+    {
+      return false;
+    }
+  }
+
+  // Movement: a table lookup per game with no branches, which the compiler
+  // can vectorize. Unless the rules say bumping into a wall costs a step,
+  // only moves that change cell use one up.
+  int cells = map.length();
+  const std::int32_t* table = &moves[0];
+  for (int i = 0; i < count; i++)
+  {
+    std::int32_t target = table[actions[i] * cells + cell[i]];
+    moved[i] = target != cell[i];
+    if (rules.limitSteps())
+    {
+      steps[i] -= rules.bumpsCostSteps() ? actions[i] != TAKE : moved[i];
+    }
+    cell[i] = target;
+  }
+
+  // Tiles: only holes, exits, rocks and picks do anything, so most games
+  // are done with after one comparison
+  for (int i = 0; i < count; i++)
+  {
+    int here = cell[i];
+    char tile = map[here];
+    int bit = tileBit[here];
+    bool used = bit >= 0 && (tiles[i] >> bit & 1);
+    bool full = picks[i] + rocks[i] >= rules.inventoryMax();
+    bool won = false;
+    bool lost = false;
+
+    if (moved[i])
+    {
+      if (tile == EXIT)
+      {
+        won = rules.exitWins(rocks[i]); // if not, the game goes on
+      }
+      else if (tile == HOLE && !used)
+      {
+        if (rocks[i] > 0)
+        {
+          rocks[i]--;
+          tiles[i] |= 1ULL << bit;
+        }
+        else
+        {
+          lost = true;
+        }
+      }
+    }
+    else if (actions[i] == TAKE && !used && !full)
+    {
+      if (tile == PICK)
+      {
+        picks[i]++;
+        tiles[i] |= 1ULL << bit;
+      }
+      else if (tile == ROCK && picks[i] > 0)
+      {
+        rocks[i]++;
+        tiles[i] |= 1ULL << bit;
+      }
+    }
+
+    // Running out of steps loses, even if the last step reached the exit
+    if (rules.limitSteps() && steps[i] < 0)
+    {
+      won = false;
+      lost = true;
+    }
+
+    rewards[i] = won ? 1.0f : (lost ? -1.0f : 0.0f);
+    done[i] = won || lost;
+    if (done[i])
+    {
+      episodes++;
+      wins += won;
+      resetGame(i);
+    }
+    observe(i);
+  }
+
+  return true;
+}
+
+// --- getObservations ---
+// Return OBSERVATION_SIZE numbers per game, one game after another
+template <typename Rules>
+const std::vector<std::int32_t>& GameBatch<Rules>::getObservations()
+{
+  return observations;
+}
+
+// --- getRewards ---
+template <typename Rules>
+const std::vector<float>& GameBatch<Rules>::getRewards()
+{
+  return rewards;
+}
+
+// --- getDone ---
+// Return 1 for each game that ended on the last step and was started over
+template <typename Rules>
+const std::vector<std::uint8_t>& GameBatch<Rules>::getDone()
+{
+  return done;
+}
+
+// --- getEpisodes ---
+// Return the number of games finished since the batch was created
+template <typename Rules>
+long GameBatch<Rules>::getEpisodes()
+{
+  return episodes;
+}
+
+// --- getWins ---
+template <typename Rules>
+long GameBatch<Rules>::getWins()
+{
+  return wins;
+}
+
+template class GameBatch<StandardRules>;
+template class GameBatch<HardcoreRules>;
+template class GameBatch<PracticeRules>;
+template class GameBatch<RuntimeRules>;
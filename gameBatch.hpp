@@ -0,0 +1,85 @@
+/*********************************************************************
+** Program name: gameBatch.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Many independent games of one map stepped together, for
+** training computer players. Instead of a board of linked spaces per game,
+** every game is a handful of numbers kept in one array per field (player
+** cell, steps left, picks, rocks, and a bit per hole filled, rock mined or
+** pick taken), so stepping every game is a few passes over flat arrays.
+** Finished games start over from the map straight away. Rules is one of the
+** rule sets in rules.hpp, for which gameBatch.cpp builds a GameBatch each.
+*********************************************************************/
+
+#ifndef GAMEBATCH_HPP
+#define GAMEBATCH_HPP
+
+#include "rules.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+template <typename Rules>
+class GameBatch
+{
+public:
+  enum Action {MOVE_UP, MOVE_DOWN, MOVE_LEFT, MOVE_RIGHT, TAKE};
+  static const int ACTIONS = 5; // TAKE inspects and accepts any offer
+
+  static const int MAX_TILES = 64; // holes, rocks and picks tracked per map
+
+  // Observation of each game: row, column, steps left, picks, rocks, then the
+  // symbols of the 3x3 spaces around the player, row by row
+  static const int OBSERVATION_SIZE = 14;
+
+private:
+  Rules rules;
+
+  // The map shared by every game
+  std::string map;
+  int rows;
+  int cols;
+  int start; // cell the player starts on, i.e. [1,1]
+  bool valid;
+  std::vector<std::int32_t> moves; // [action * cells + cell]: cell reached
+  std::vector<std::int8_t> tileBit; // bit of each hole, rock or pick; -1 if none
+
+  // One entry per game
+  int count;
+  std::vector<std::int32_t> cell;
+  std::vector<std::int32_t> steps;
+  std::vector<std::uint8_t> picks;
+  std::vector<std::uint8_t> rocks;
+  std::vector<std::uint64_t> tiles; // bits of tiles used up
+  std::vector<std::uint8_t> moved; // scratch for step
+
+  // Results of the last step, one entry (or observation) per game
+  std::vector<std::int32_t> observations;
+  std::vector<float> rewards;
+  std::vector<std::uint8_t> done;
+
+  long episodes;
+  long wins;
+
+  char tileAt(int game, int row, int col);
+  void resetGame(int game);
+  void observe(int game);
+
+public:
+  GameBatch(const std::string& map, int rows, int cols, int count,
+            const Rules& rules = Rules());
+
+  bool isValid();
+  int getCount();
+
+  void reset();
+  bool step(const std::vector<std::uint8_t>& actions);
+
+  const std::vector<std::int32_t>& getObservations();
+  const std::vector<float>& getRewards();
+  const std::vector<std::uint8_t>& getDone();
+  long getEpisodes();
+  long getWins();
+};
+
+#endif
@@ -0,0 +1,539 @@
+/*********************************************************************
+** Program name: gameServer.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Hosts many game sessions in one process over a localhost TCP
+** port or a Unix domain socket. Each worker thread runs its own epoll event
+** loop over non-blocking connections: a line from a player is handed to that
+** player's Session and the reply is written back, so no thread ever waits on
+** one player. Spectators are sent the frames of the game they watch, shared
+** with every other watcher, as the game is played. Linux only.
+*********************************************************************/
+
+#include "gameServer.hpp"
+#include "session.hpp"
+#include "board.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  const int MAX_EVENTS = 256; // per call to epoll_wait
+  const int WAIT_MILLISECONDS = 200; // how often to check for stop
+  const int BACKLOG = 4096;
+  const int MAX_PARTS = 64; // replies and frames sent per call to sendmsg
+}
+
+// --- Connection::Connection ---
+GameServer::Connection::Connection(int fd,
+                                   const std::shared_ptr<const std::string>& map,
+                                   int rows, int cols, SharedCave* cave,
+                                   BroadcastList* broadcasts, long number)
+  : session(map, rows, cols, cave, broadcasts, number, number)
+{
+  this->fd = fd;
+  sent = 0;
+  writing = false;
+  reading = true;
+  next = 0;
+}
+
+// --- Constructor ---
+// Serves map to every player, each in a session of their own, and as one
+// shared cave for the players who join it
+GameServer::GameServer(const std::string& map, int rows, int cols)
+  : cave(map, rows, cols)
+{
+  this->map = Board::shareMap(map);
+  this->rows = rows;
+  this->cols = cols;
+  listenFd = -1;
+  stopping = false;
+  sessions = 0;
+  finished = 0;
+  turns = 0;
+  games = 0;
+}
+
+// --- Destructor ---
+GameServer::~GameServer()
+{
+  if (listenFd >= 0)
+  {
+    ::close(listenFd);
+  }
+  if (!unixPath.empty())
+  {
+    unlink(unixPath.c_str());
+  }
+}
+
+// --- listenTcp ---
+// Listens on port of 127.0.0.1; returns false on failure
+bool GameServer::listenTcp(int port)
+{
+  listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+  if (listenFd < 0)
+  {
+    return false;
+  }
+
+  int on = 1;
+  setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+  sockaddr_in address;
+  std::memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  return bind(listenFd, reinterpret_cast<sockaddr*>(&address),
+              sizeof(address)) == 0 &&
+         listen(listenFd, BACKLOG) == 0;
+}
+
+// --- listenUnix ---
+// Listens on a Unix domain socket at path, replacing any old socket there;
+// returns false on failure
+bool GameServer::listenUnix(const std::string& path)
+{
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.length() >= sizeof(address.sun_path))
+  {
+    return false;
+  }
+  path.copy(address.sun_path, path.length());
+
+  listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+  if (listenFd < 0)
+  {
+    return false;
+  }
+
+  unlink(path.c_str());
+  if (bind(listenFd, reinterpret_cast<sockaddr*>(&address),
+           sizeof(address)) != 0 ||
+      listen(listenFd, BACKLOG) != 0)
+  {
+    return false;
+  }
+  unixPath = path;
+  return true;
+}
+
+// --- run ---
+// Serves players on threads event loops until stop is called; every loop
+// waits on the listening socket, and a new player is taken by one of them
+void GameServer::run(int threads)
+{
+  std::vector<std::thread> workers;
+  for (int t = 1; t < threads; t++)
+  {
+    workers.push_back(std::thread(&GameServer::loop, this));
+  }
+  loop(); // the calling thread runs a loop too
+  for (int t = 0, n = workers.size(); t < n; t++)
+  {
+    workers[t].join();
+  }
+}
+
+// --- stop ---
+// Makes run return soon; safe to call from a signal handler
+void GameServer::stop()
+{
+  stopping = true;
+}
+
+// --- loop ---
+// One event loop, with the connections it accepted
+void GameServer::loop()
+{
+  Loop loop;
+  loop.epollFd = epoll_create1(0);
+  if (loop.epollFd < 0)
+  {
+    return;
+  }
+  loop.wakeFd = eventfd(0, EFD_NONBLOCK);
+  if (loop.wakeFd < 0)
+  {
+    ::close(loop.epollFd);
+    return;
+  }
+
+  epoll_event listenEvent;
+  listenEvent.events = EPOLLIN;
+#ifdef EPOLLEXCLUSIVE
+  listenEvent.events |= EPOLLEXCLUSIVE; // wake one loop per new player
+#endif
+  listenEvent.data.fd = listenFd;
+  epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, listenFd, &listenEvent);
+
+  epoll_event wakeEvent;
+  wakeEvent.events = EPOLLIN;
+  wakeEvent.data.fd = loop.wakeFd;
+  epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, loop.wakeFd, &wakeEvent);
+
+  epoll_event events[MAX_EVENTS];
+  while (!stopping)
+  {
+    int count = epoll_wait(loop.epollFd, events, MAX_EVENTS,
+                           WAIT_MILLISECONDS);
+    for (int i = 0; i < count; i++)
+    {
+      int fd = events[i].data.fd;
+      if (fd == listenFd)
+      {
+        acceptAll(loop);
+        continue;
+      }
+      if (fd == loop.wakeFd)
+      {
+        wakeWatchers(loop);
+        continue;
+      }
+
+      Connections::iterator found = loop.connections.find(fd);
+      if (found == loop.connections.end())
+      {
+        continue;
+      }
+      Connection& connection = *found->second;
+
+      // Lines left over from when the output was full are answered on the
+      // next EPOLLOUT, which flush asks for while there are any
+      bool open = (events[i].events & (EPOLLERR | EPOLLHUP)) == 0;
+      if (open && (events[i].events & (EPOLLIN | EPOLLOUT)))
+      {
+        open = receive(connection);
+        watch(loop, connection);
+      }
+      if (open)
+      {
+        open = flush(loop.epollFd, connection);
+      }
+      if (!open)
+      {
+        close(loop, fd);
+      }
+    }
+  }
+
+  while (!loop.connections.empty())
+  {
+    close(loop, loop.connections.begin()->first);
+  }
+  ::close(loop.wakeFd);
+  ::close(loop.epollFd);
+}
+
+// --- acceptAll ---
+// Accepts every player waiting to connect and sends each the main menu
+void GameServer::acceptAll(Loop& loop)
+{
+  while (true)
+  {
+    int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK);
+    if (fd < 0)
+    {
+      return; // none left, or out of descriptors until some close
+    }
+
+    int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on)); // TCP only
+
+    long number = ++sessions;
+    std::unique_ptr<Connection> connection(
+      new Connection(fd, map, rows, cols, &cave, &broadcasts, number));
+    std::string reply;
+    connection->session.start(reply);
+    connection->output.push_back(Broadcast::Frame(new std::string(reply)));
+
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+      ::close(fd);
+      finished++;
+      continue;
+    }
+
+    Connection& added = *connection;
+    loop.connections[fd] = std::move(connection);
+    if (!flush(loop.epollFd, added))
+    {
+      close(loop, fd);
+    }
+  }
+}
+
+// --- receive ---
+// Reads what the player sent and hands each whole line to their session,
+// adding the replies to the output. Stops reading once the output is full,
+// leaving the rest in the socket until flush has sent enough of it. Returns
+// false if the connection should close.
+bool GameServer::receive(Connection& connection)
+{
+  char buffer[4096];
+  while (answer(connection))
+  {
+    if (connection.input.length() > MAX_LINE)
+    {
+      return false;
+    }
+
+    ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+    if (received == 0)
+    {
+      return false; // the player hung up
+    }
+    if (received < 0)
+    {
+      return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    }
+    connection.input.append(buffer, received);
+  }
+  return true;
+}
+
+// --- answer ---
+// Hands the whole lines received to the session while the output has room
+// for the replies; returns true if every whole line was answered
+bool GameServer::answer(Connection& connection)
+{
+  std::size_t start = 0;
+  std::size_t end;
+  std::string reply;
+  while (connection.output.size() < MAX_QUEUED &&
+         (end = connection.input.find('\n', start)) != std::string::npos)
+  {
+    std::size_t length = end - start;
+    if (length > 0 && connection.input[end - 1] == '\r')
+    {
+      length--;
+    }
+
+    if (connection.session.getPhase() != Session::CLOSED)
+    {
+      int played = connection.session.getGames();
+      connection.session.input(connection.input.substr(start, length), reply);
+      if (!reply.empty())
+      {
+        connection.output.push_back(Broadcast::Frame(new std::string(reply)));
+      }
+      turns++;
+      games += connection.session.getGames() - played;
+    }
+    start = end + 1;
+  }
+  connection.input.erase(0, start);
+  return connection.input.find('\n') == std::string::npos;
+}
+
+// --- watch ---
+// Starts or stops pulling frames for the connection as its session starts or
+// stops watching a game
+void GameServer::watch(Loop& loop, Connection& connection)
+{
+  std::shared_ptr<Broadcast> watched = connection.session.getWatched();
+  if (watched == connection.watching)
+  {
+    return;
+  }
+
+  if (connection.watching)
+  {
+    connection.watching->unwatch(loop.wakeFd);
+    loop.watchers.erase(connection.fd);
+  }
+  connection.watching = watched;
+  if (watched)
+  {
+    watched->watch(loop.wakeFd);
+    loop.watchers.insert(connection.fd);
+    connection.next = 0; // start from a keyframe
+    pull(loop, connection);
+  }
+}
+
+// --- pull ---
+// Adds the frames of the watched game the connection has not had to its
+// output. A watcher that has fallen too far behind loses the frames it has
+// not been sent and gets a keyframe instead, so a slow spectator costs the
+// game nothing.
+void GameServer::pull(Loop& loop, Connection& connection)
+{
+  if (connection.output.size() > MAX_PENDING)
+  {
+    // Keep the first frame if part of it is sent, or the screen is garbled
+    std::size_t keep = connection.sent > 0 ? 1 : 0;
+    connection.output.resize(keep);
+    connection.next = 0;
+  }
+
+  if (!connection.watching->pull(connection.next, connection.output))
+  {
+    std::string reply;
+    connection.session.stopWatching(reply);
+    connection.output.push_back(Broadcast::Frame(new std::string(reply)));
+    connection.watching->unwatch(loop.wakeFd);
+    connection.watching.reset();
+    loop.watchers.erase(connection.fd);
+  }
+}
+
+// --- wakeWatchers ---
+// Sends the new frames of the games watched from this loop
+void GameServer::wakeWatchers(Loop& loop)
+{
+  std::uint64_t count;
+  if (read(loop.wakeFd, &count, sizeof(count)) < 0)
+  {
+    return; // woken by a frame already sent
+  }
+
+  std::vector<int> watchers(loop.watchers.begin(), loop.watchers.end());
+  for (std::size_t i = 0; i < watchers.size(); i++)
+  {
+    Connection& connection = *loop.connections[watchers[i]];
+    pull(loop, connection);
+    if (!flush(loop.epollFd, connection))
+    {
+      close(loop, watchers[i]);
+    }
+  }
+}
+
+// --- flush ---
+// Sends as much output as the socket takes, then waits for it to take the
+// rest if there is any; returns false if the connection should close, which
+// it should once the player has left and seen the last reply. Frames shared
+// with other watchers are sent from where they are, without copying them.
+bool GameServer::flush(int epollFd, Connection& connection)
+{
+  while (!connection.output.empty())
+  {
+    iovec parts[MAX_PARTS];
+    int count = 0;
+    for (std::deque<Broadcast::Frame>::iterator i = connection.output.begin();
+         i != connection.output.end() && count < MAX_PARTS; ++i, count++)
+    {
+      std::size_t skip = count == 0 ? connection.sent : 0;
+      parts[count].iov_base = const_cast<char*>((*i)->data() + skip);
+      parts[count].iov_len = (*i)->length() - skip;
+    }
+
+    msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov = parts;
+    message.msg_iovlen = count;
+    ssize_t written = sendmsg(connection.fd, &message, MSG_NOSIGNAL);
+    if (written < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      if (errno != EAGAIN && errno != EWOULDBLOCK)
+      {
+        return false;
+      }
+      break;
+    }
+
+    // Drop what was sent
+    std::size_t left = written;
+    while (left > 0 &&
+           left >= connection.output.front()->length() - connection.sent)
+    {
+      left -= connection.output.front()->length() - connection.sent;
+      connection.output.pop_front();
+      connection.sent = 0;
+    }
+    connection.sent += left;
+  }
+
+  bool done = connection.output.empty();
+  if (done && connection.session.getPhase() == Session::CLOSED)
+  {
+    return false;
+  }
+
+  // Only wait for the socket to be writable while there is output left, or
+  // lines held back for lack of room that the next EPOLLOUT will answer, and
+  // only read from it while the output has room
+  bool writing = !done || connection.input.find('\n') != std::string::npos;
+  bool reading = connection.output.size() < MAX_QUEUED;
+  if (writing != connection.writing || reading != connection.reading)
+  {
+    epoll_event event;
+    event.events = (reading ? EPOLLIN : 0) | (writing ? EPOLLOUT : 0);
+    event.data.fd = connection.fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+    connection.writing = writing;
+    connection.reading = reading;
+  }
+  return true;
+}
+
+// --- close ---
+// Closes the connection on fd and ends its session
+void GameServer::close(Loop& loop, int fd)
+{
+  Connections::iterator found = loop.connections.find(fd);
+  if (found != loop.connections.end() && found->second->watching)
+  {
+    found->second->watching->unwatch(loop.wakeFd);
+    loop.watchers.erase(fd);
+  }
+  epoll_ctl(loop.epollFd, EPOLL_CTL_DEL, fd, nullptr);
+  ::close(fd);
+  loop.connections.erase(fd);
+  finished++;
+}
+
+// --- getSessions ---
+// Returns the number of players who have connected
+long GameServer::getSessions()
+{
+  return sessions;
+}
+
+// --- getFinished ---
+// Returns the number of players who have left
+long GameServer::getFinished()
+{
+  return finished;
+}
+
+// --- getTurns ---
+// Returns the number of lines handled over every session
+long GameServer::getTurns()
+{
+  return turns;
+}
+
+// --- getGames ---
+// Returns the number of games started over every session
+long GameServer::getGames()
+{
+  return games;
+}
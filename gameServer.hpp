@@ -0,0 +1,106 @@
+/*********************************************************************
+** Program name: gameServer.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Hosts many game sessions in one process over a localhost TCP
+** port or a Unix domain socket. Each worker thread runs its own epoll event
+** loop over non-blocking connections: a line from a player is handed to that
+** player's Session and the reply is written back, so no thread ever waits on
+** one player. Spectators are sent the frames of the game they watch, shared
+** with every other watcher, as the game is played. Linux only.
+*********************************************************************/
+
+#ifndef GAMESERVER_HPP
+#define GAMESERVER_HPP
+
+#include "broadcast.hpp"
+#include "session.hpp"
+#include "sharedCave.hpp"
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+class GameServer
+{
+private:
+  static const std::size_t MAX_LINE = 1024; // longer lines close the connection
+  static const std::size_t MAX_PENDING = 32; // frames a watcher may fall behind
+  // Replies and frames waiting to be sent before the player's input is left
+  // unread until they are
+  static const std::size_t MAX_QUEUED = 64;
+
+  // A connected player
+  struct Connection
+  {
+    int fd;
+    Session session;
+    std::string input; // received but not yet answered
+    std::deque<Broadcast::Frame> output; // replies and frames not yet sent
+    std::size_t sent; // bytes of the first output sent
+    bool writing; // waiting for the socket to take more output
+    bool reading; // waiting for input; not while the output is full
+    std::shared_ptr<Broadcast> watching; // game the session is watching
+    unsigned long long next; // number of the next frame to pull from it
+
+    Connection(int fd, const std::shared_ptr<const std::string>& map, int rows,
+               int cols, SharedCave* cave, BroadcastList* broadcasts,
+               long number);
+  };
+
+  typedef std::unordered_map<int, std::unique_ptr<Connection> > Connections;
+
+  // One event loop and the connections it accepted
+  struct Loop
+  {
+    int epollFd;
+    int wakeFd; // eventfd written when a game watched here has new frames
+    Connections connections;
+    std::unordered_set<int> watchers; // connections watching a game
+  };
+
+  std::shared_ptr<const std::string> map; // shared by every session
+  int rows;
+  int cols;
+  SharedCave cave; // the map as one game for every player who joins it
+  BroadcastList broadcasts; // games being played, for spectators
+  int listenFd;
+  std::string unixPath; // removed on shutdown; empty for TCP
+
+  std::atomic<bool> stopping;
+  std::atomic<long> sessions; // connections accepted
+  std::atomic<long> finished; // connections closed
+  std::atomic<long> turns; // lines handled
+  std::atomic<long> games;
+
+  GameServer(const GameServer&) = delete;
+  GameServer& operator=(const GameServer&) = delete;
+
+  void loop();
+  void acceptAll(Loop& loop);
+  bool receive(Connection& connection);
+  bool answer(Connection& connection);
+  void watch(Loop& loop, Connection& connection);
+  void pull(Loop& loop, Connection& connection);
+  void wakeWatchers(Loop& loop);
+  bool flush(int epollFd, Connection& connection);
+  void close(Loop& loop, int fd);
+
+public:
+  GameServer(const std::string& map, int rows, int cols);
+  ~GameServer();
+
+  bool listenTcp(int port);
+  bool listenUnix(const std::string& path);
+  void run(int threads);
+  void stop();
+
+  long getSessions();
+  long getFinished();
+  long getTurns();
+  long getGames();
+};
+
+#endif
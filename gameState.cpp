@@ -0,0 +1,644 @@
+/*********************************************************************
+** Program name: gameState.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: The rules of the game without any console input or output.
+** Each call to step carries out one action and returns what happened as a
+** list of events, so the game can be driven by the console, by simulations
+** or by a solver at full speed.
+*********************************************************************/
+
+#include "gameState.hpp"
+#include "board.hpp"
+#include "event.hpp"
+#include "player.hpp"
+#include "space.hpp"
+#include "symbols.hpp"
+#include "bytes.hpp"
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  // Returns true if saved, a step count read from a saved state, is one a
+  // game can have: from START_STEPS down to -1, the count of a game lost by
+  // running out
+  bool validSteps(unsigned long long saved)
+  {
+    int steps = static_cast<int>(static_cast<unsigned>(saved));
+    return steps >= -1 && steps <= GameState::START_STEPS;
+  }
+
+  // Returns true if inventory, read from a saved state, is a number of rocks
+  // and picks the player can carry
+  bool validInventory(const std::string& inventory)
+  {
+    return inventory.length() <=
+             static_cast<std::size_t>(Player::INVENTORY_MAX) &&
+           inventory.find_first_not_of(std::string(1, ROCK) + PICK) ==
+             std::string::npos;
+  }
+}
+
+// --- Constructor ---
+// Starts a game on board, which is deleted along with the game state; in an
+// endless game exits lead to the next segment instead of winning
+GameState::GameState(Board* board, bool endless)
+{
+  this->board = board;
+  this->endless = endless;
+  start = board->getPlayerSpace();
+  steps = START_STEPS;
+  offer = Space::NO_OFFER;
+
+  player.setState(Player::PLAYING);
+  player.setEndless(endless);
+
+  outcome.valid = true;
+  outcome.moved = false;
+  outcome.offer = Space::NO_OFFER;
+}
+
+// --- Destructor ---
+GameState::~GameState()
+{
+  delete board;
+}
+
+// --- addEvent ---
+void GameState::addEvent(Event::Type type, int value)
+{
+  Event event = { type, value };
+  outcome.events.push_back(event);
+}
+
+// --- recordChange ---
+// Remembers space's symbol before the rules changed it, if they did; endless
+// caves are never reset, so nothing is recorded for them
+void GameState::recordChange(Space* space, char symbol)
+{
+  if (!endless && space->getDefaultSymbol() != symbol)
+  {
+    Change change = { space, symbol };
+    changes.push_back(change);
+  }
+}
+
+// --- step ---
+// Carries out one action by the player and returns its outcome, which stays
+// valid until the next call. While an offer is waiting, only ACCEPT and
+// DECLINE are valid, besides UNDO; once the game is over, only UNDO is valid.
+const GameState::Outcome& GameState::step(GameState::Action action)
+{
+  outcome.events.clear();
+  outcome.valid = true;
+  outcome.moved = false;
+
+  if (action == UNDO)
+  {
+    outcome.valid = undo();
+  }
+  else if (action == REDO)
+  {
+    outcome.valid = redo();
+  }
+  else
+  {
+    std::size_t turns = history.size();
+    play(action);
+    if (history.size() != turns)
+    {
+      undone.clear(); // a new action replaces whatever was taken back
+    }
+  }
+
+  outcome.offer = offer;
+  return outcome;
+}
+
+// --- play ---
+// Carries out any action but UNDO and REDO, adding it to the history if it
+// changed the game
+void GameState::play(GameState::Action action)
+{
+  if (player.getState() != Player::PLAYING)
+  {
+    outcome.valid = false;
+    return;
+  }
+
+  // Only the offer, a move or the end of the game change anything: steps,
+  // items and spaces change only along with one of them
+  Turn turn;
+  getTurn(action, turn);
+  Space* space = board->getPlayerSpace();
+
+  if (offer != Space::NO_OFFER) // player must answer the offer first
+  {
+    if (action == ACCEPT)
+    {
+      char symbol = space->getDefaultSymbol();
+      space->accept(&player, outcome.events);
+      recordChange(space, symbol);
+      offer = Space::NO_OFFER;
+    }
+    else if (action == DECLINE)
+    {
+      offer = Space::NO_OFFER;
+    }
+    else
+    {
+      outcome.valid = false;
+    }
+
+    if (outcome.valid && !endless) // every answer clears the offer
+    {
+      history.push_back(turn);
+    }
+    return;
+  }
+
+  int segment = player.getSegment();
+
+  switch (action)
+  {
+    case MOVE_UP:
+    case MOVE_DOWN:
+    case MOVE_LEFT:
+    case MOVE_RIGHT:
+    {
+      Space::Direction direction = Space::UP;
+      if (action == MOVE_DOWN)
+      {
+        direction = Space::DOWN;
+      }
+      else if (action == MOVE_LEFT)
+      {
+        direction = Space::LEFT;
+      }
+      else if (action == MOVE_RIGHT)
+      {
+        direction = Space::RIGHT;
+      }
+
+      if (board->playerMove(direction))
+      {
+        Space* target = board->getPlayerSpace();
+        char symbol = target->getDefaultSymbol();
+        target->arrive(&player, outcome.events);
+        recordChange(target, symbol);
+        steps--; // only successful moves use up a step
+        outcome.moved = true;
+      }
+      break;
+    }
+    case INSPECT:
+      offer = space->inspect(&player, outcome.events);
+      break;
+    case INVENTORY:
+      addEvent(Event::INVENTORY, 0);
+      break;
+    case QUIT:
+      player.setState(Player::LOSE);
+      addEvent(Event::QUIT, 0);
+      break;
+    case ACCEPT:
+    case DECLINE:
+    case UNDO:
+    case REDO:
+      outcome.valid = false; // nothing has been offered
+      break;
+  }
+
+  // Steps are refilled on reaching the next segment of an endless cave
+  if (player.getSegment() != segment)
+  {
+    steps = START_STEPS;
+    addEvent(Event::SEGMENT_REACHED, player.getSegment());
+  }
+
+  // Game over if run out of steps, even if the last step reached the exit
+  if (steps < 0)
+  {
+    player.setState(Player::LOSE);
+    addEvent(Event::OUT_OF_STEPS, 0);
+  }
+
+  // Endless caves have no history; like reset, undo is not available
+  if (!endless && (outcome.moved || offer != turn.offer ||
+                   player.getState() != turn.state))
+  {
+    history.push_back(turn);
+  }
+}
+
+// --- getTurn ---
+// Fills in turn with the game as it is before action
+void GameState::getTurn(GameState::Action action, Turn& turn)
+{
+  const Player::Inventory& inventory = player.getInventory();
+
+  turn.action = action;
+  turn.changes = changes.size();
+  turn.playerSpace = board->getPlayerSpace();
+  turn.steps = steps;
+  turn.offer = offer;
+  turn.state = player.getState();
+  turn.segment = player.getSegment();
+  turn.items = inventory.size();
+  for (int i = 0; i < turn.items; i++)
+  {
+    turn.inventory[i] = inventory[i];
+  }
+}
+
+// --- undo ---
+// Takes back the last action in the history by putting back what it changed,
+// so it costs the same however big the board is; returns false if there is
+// nothing to take back
+bool GameState::undo()
+{
+  if (history.empty())
+  {
+    return false;
+  }
+
+  restoreTurn(history.back());
+  undone.push_back(history.back().action);
+  history.pop_back();
+  return true;
+}
+
+// --- restoreTurn ---
+// Puts the game back as it was before turn, restoring the spaces changed
+// since then
+void GameState::restoreTurn(const Turn& turn)
+{
+  for (std::size_t i = changes.size(); i > turn.changes; i--)
+  {
+    changes[i - 1].space->restore(changes[i - 1].symbol);
+  }
+  changes.resize(turn.changes);
+
+  board->placePlayer(turn.playerSpace);
+  steps = turn.steps;
+  offer = turn.offer;
+  player.reset();
+  player.setState(turn.state);
+  player.setSegment(turn.segment);
+  for (int i = 0; i < turn.items; i++)
+  {
+    player.addItem(turn.inventory[i]);
+  }
+}
+
+// --- redo ---
+// Carries out the last action taken back by undo again; returns false if
+// there is none, or if another action has been taken since
+bool GameState::redo()
+{
+  if (undone.empty())
+  {
+    return false;
+  }
+
+  Action action = undone.back();
+  undone.pop_back();
+  play(action);
+  return outcome.valid;
+}
+
+// --- reset ---
+// Starts a new game on the same board by undoing every change made since the
+// last reset, which costs far less than building a new board. Endless caves
+// forget spaces as they scroll, so they cannot be reset; returns false.
+bool GameState::reset()
+{
+  if (endless)
+  {
+    return false;
+  }
+
+  for (int i = changes.size() - 1; i >= 0; i--)
+  {
+    changes[i].space->restore(changes[i].symbol);
+  }
+  changes.clear();
+  history.clear();
+  undone.clear();
+
+  board->placePlayer(start);
+  player.reset();
+  player.setState(Player::PLAYING);
+  steps = START_STEPS;
+  offer = Space::NO_OFFER;
+
+  outcome.events.clear();
+  outcome.valid = true;
+  outcome.moved = false;
+  outcome.offer = Space::NO_OFFER;
+  return true;
+}
+
+// --- getMark ---
+// Returns a mark for the current point in the game, which rollback can return
+// to; like reset, not available for endless caves
+GameState::Mark GameState::getMark()
+{
+  Mark mark = { history.size() };
+  return mark;
+}
+
+// --- rollback ---
+// Undoes every action taken since mark was made in one go, restoring only
+// the spaces they changed; used by the computer player and the solver to try
+// out moves on the board itself
+void GameState::rollback(const Mark& mark)
+{
+  if (history.size() > mark.turns)
+  {
+    restoreTurn(history[mark.turns]);
+    history.resize(mark.turns);
+  }
+  undone.clear();
+
+  outcome.events.clear();
+  outcome.offer = offer;
+}
+
+// --- getHistorySize ---
+// Returns the number of actions undo can take back
+std::size_t GameState::getHistorySize()
+{
+  return history.size();
+}
+
+// --- getRedoSize ---
+// Returns the number of actions redo can carry out again
+std::size_t GameState::getRedoSize()
+{
+  return undone.size();
+}
+
+// --- saveState ---
+// Appends everything needed to carry on the game from this point to out:
+// steps, any offer waiting, the player, the history undo works from if
+// withHistory is true, and the board. Without the history the state stays
+// the same size however long the game has gone on, but nothing before it can
+// be undone once it is loaded.
+void GameState::saveState(std::string& out, bool withHistory)
+{
+  const Player::Inventory& inventory = player.getInventory();
+
+  Bytes::putInt(out, static_cast<unsigned>(steps), 4);
+  Bytes::putInt(out, offer, 1);
+  Bytes::putInt(out, player.getState(), 1);
+  Bytes::putInt(out, player.getSegment(), 4);
+  Bytes::putString(out, std::string(inventory.begin(), inventory.end()));
+  if (withHistory)
+  {
+    saveHistory(out);
+  }
+  else
+  {
+    Bytes::putInt(out, 0, 4); // an empty history
+  }
+  board->saveState(out, changedSpaces());
+}
+
+// --- saveHistory ---
+// Appends the history to out: for each action, the game before it and the
+// spaces it changed, located by row and column
+void GameState::saveHistory(std::string& out)
+{
+  Bytes::putInt(out, history.size(), 4);
+  for (std::size_t i = 0; i < history.size(); i++)
+  {
+    const Turn& turn = history[i];
+    std::size_t end = i + 1 < history.size() ? history[i + 1].changes :
+                                               changes.size();
+    int row;
+    int col;
+
+    Bytes::putInt(out, turn.action, 1);
+    board->locate(turn.playerSpace, row, col);
+    Bytes::putInt(out, row, 4);
+    Bytes::putInt(out, col, 4);
+    Bytes::putInt(out, static_cast<unsigned>(turn.steps), 4);
+    Bytes::putInt(out, turn.offer, 1);
+    Bytes::putInt(out, turn.state, 1);
+    Bytes::putInt(out, turn.segment, 4);
+    Bytes::putString(out, std::string(turn.inventory,
+                                      turn.inventory + turn.items));
+
+    Bytes::putInt(out, end - turn.changes, 4);
+    for (std::size_t j = turn.changes; j < end; j++)
+    {
+      board->locate(changes[j].space, row, col);
+      Bytes::putInt(out, row, 4);
+      Bytes::putInt(out, col, 4);
+      Bytes::putInt(out, static_cast<unsigned char>(changes[j].symbol), 1);
+    }
+  }
+}
+
+// --- loadHistory ---
+// Reads a history written by saveHistory into turns, along with the changes
+// made by them in order; returns false if it is not valid for this board
+bool GameState::loadHistory(const std::string& in, std::size_t& pos,
+                            std::vector<Turn>& turns,
+                            std::vector<Change>& turnChanges)
+{
+  unsigned long long count;
+  if (!Bytes::getInt(in, pos, 4, count) || (endless && count > 0) ||
+      count > in.length() - pos)
+  {
+    return false;
+  }
+
+  for (unsigned long long i = 0; i < count; i++)
+  {
+    unsigned long long action;
+    unsigned long long row;
+    unsigned long long col;
+    unsigned long long savedSteps;
+    unsigned long long savedOffer;
+    unsigned long long savedState;
+    unsigned long long savedSegment;
+    unsigned long long changeCount;
+    std::string inventory;
+    if (!Bytes::getInt(in, pos, 1, action) ||
+        !Bytes::getInt(in, pos, 4, row) || !Bytes::getInt(in, pos, 4, col) ||
+        !Bytes::getInt(in, pos, 4, savedSteps) ||
+        !Bytes::getInt(in, pos, 1, savedOffer) ||
+        !Bytes::getInt(in, pos, 1, savedState) ||
+        !Bytes::getInt(in, pos, 4, savedSegment) ||
+        !Bytes::getString(in, pos, inventory) ||
+        !Bytes::getInt(in, pos, 4, changeCount) ||
+        action > DECLINE || !validSteps(savedSteps) ||
+        savedOffer > Space::TAKE_PICK || savedState > Player::LOSE ||
+        !validInventory(inventory) || changeCount > in.length() - pos)
+    {
+      return false;
+    }
+
+    Turn turn;
+    turn.action = static_cast<Action>(action);
+    turn.changes = turnChanges.size();
+    turn.playerSpace = board->getSpace(row, col);
+    turn.steps = static_cast<int>(static_cast<unsigned>(savedSteps));
+    turn.offer = static_cast<Space::Offer>(savedOffer);
+    turn.state = static_cast<Player::State>(savedState);
+    turn.segment = savedSegment;
+    turn.items = inventory.length();
+    inventory.copy(turn.inventory, turn.items);
+    if (turn.playerSpace == nullptr)
+    {
+      return false;
+    }
+    turns.push_back(turn);
+
+    for (unsigned long long j = 0; j < changeCount; j++)
+    {
+      unsigned long long symbol;
+      if (!Bytes::getInt(in, pos, 4, row) || !Bytes::getInt(in, pos, 4, col) ||
+          !Bytes::getInt(in, pos, 1, symbol))
+      {
+        return false;
+      }
+
+      Change change = { board->getSpace(row, col), static_cast<char>(symbol) };
+      if (change.space == nullptr)
+      {
+        return false;
+      }
+      turnChanges.push_back(change);
+    }
+  }
+  return true;
+}
+
+// --- changedSpaces ---
+// Returns the spaces changed since the game started, each with its symbol
+// before the change, as used by Board::saveState and Board::loadState
+std::vector<std::pair<Space*, char> > GameState::changedSpaces()
+{
+  std::vector<std::pair<Space*, char> > changed;
+  changed.reserve(changes.size());
+  for (std::size_t i = 0; i < changes.size(); i++)
+  {
+    changed.push_back(std::make_pair(changes[i].space, changes[i].symbol));
+  }
+  return changed;
+}
+
+// --- loadState ---
+// Carries on the game from a state written by saveState on the same map or
+// endless cave. Only the spaces changed now and in the state are touched, so
+// this is quick even on a huge map. Spaces changed in the state become the
+// changes undone by reset, and the actions in the state's history can be
+// undone. Returns false, changing nothing, if the state is not valid.
+bool GameState::loadState(const std::string& in)
+{
+  std::size_t pos = 0;
+  unsigned long long savedSteps;
+  unsigned long long savedOffer;
+  unsigned long long savedState;
+  unsigned long long savedSegment;
+  std::string inventory;
+  if (!Bytes::getInt(in, pos, 4, savedSteps) ||
+      !Bytes::getInt(in, pos, 1, savedOffer) ||
+      !Bytes::getInt(in, pos, 1, savedState) ||
+      !Bytes::getInt(in, pos, 4, savedSegment) ||
+      !Bytes::getString(in, pos, inventory) ||
+      !validSteps(savedSteps) || savedOffer > Space::TAKE_PICK ||
+      savedState > Player::LOSE || !validInventory(inventory))
+  {
+    return false;
+  }
+
+  std::vector<Turn> turns;
+  std::vector<Change> turnChanges;
+  if (!loadHistory(in, pos, turns, turnChanges))
+  {
+    return false;
+  }
+
+  std::vector<std::pair<Space*, char> > changed = changedSpaces();
+  if (!board->loadState(in, pos, changed))
+  {
+    return false;
+  }
+
+  // Changes made before the history come first, so that undoing the history
+  // leaves them in place
+  changes.clear();
+  if (!endless)
+  {
+    for (std::size_t i = 0; i < changed.size(); i++)
+    {
+      bool inHistory = false;
+      for (std::size_t j = 0; j < turnChanges.size() && !inHistory; j++)
+      {
+        inHistory = turnChanges[j].space == changed[i].first;
+      }
+      if (!inHistory)
+      {
+        Change change = { changed[i].first, changed[i].second };
+        changes.push_back(change);
+      }
+    }
+  }
+  for (std::size_t i = 0; i < turns.size(); i++)
+  {
+    turns[i].changes += changes.size();
+  }
+  changes.insert(changes.end(), turnChanges.begin(), turnChanges.end());
+  history.swap(turns);
+  undone.clear();
+
+  steps = static_cast<int>(static_cast<unsigned>(savedSteps));
+  offer = static_cast<Space::Offer>(savedOffer);
+  player.reset();
+  player.setState(static_cast<Player::State>(savedState));
+  player.setEndless(endless);
+  player.setSegment(savedSegment);
+  for (std::size_t i = 0; i < inventory.length(); i++)
+  {
+    player.addItem(inventory[i]);
+  }
+
+  outcome.events.clear();
+  outcome.valid = true;
+  outcome.moved = false;
+  outcome.offer = offer;
+  return true;
+}
+
+// --- getBoard ---
+Board* GameState::getBoard()
+{
+  return board;
+}
+
+// --- getPlayer ---
+Player* GameState::getPlayer()
+{
+  return &player;
+}
+
+// --- getSteps ---
+// Return the number of steps remaining
+int GameState::getSteps()
+{
+  return steps;
+}
+
+// --- getOffer ---
+// Return the offer waiting for an answer, or Space::NO_OFFER
+Space::Offer GameState::getOffer()
+{
+  return offer;
+}
@@ -0,0 +1,128 @@
+/*********************************************************************
+** Program name: gameState.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: The rules of the game without any console input or output.
+** Each call to step carries out one action and returns what happened as a
+** list of events, so the game can be driven by the console, by simulations
+** or by a solver at full speed.
+*********************************************************************/
+
+#ifndef GAMESTATE_HPP
+#define GAMESTATE_HPP
+
+#include "board.hpp"
+#include "event.hpp"
+#include "player.hpp"
+#include "space.hpp"
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+class GameState
+{
+public:
+  static const int START_STEPS = 22;
+
+  enum Action
+  {
+    MOVE_UP,
+    MOVE_DOWN,
+    MOVE_LEFT,
+    MOVE_RIGHT,
+    INSPECT,
+    INVENTORY,
+    QUIT,
+    ACCEPT, // answer to an offer made by inspecting
+    DECLINE,
+    UNDO, // take back the last action that changed the game
+    REDO // carry out the last action taken back again
+  };
+
+  struct Outcome
+  {
+    bool valid; // false if the action could not be taken at this point
+    bool moved; // true if the player moved to another space
+    Space::Offer offer; // offer waiting for ACCEPT or DECLINE, if any
+    EventList events; // what happened, in order
+  };
+
+  // A point in the same game that rollback can return to
+  struct Mark
+  {
+    std::size_t turns; // actions in the history at that point
+  };
+
+private:
+  // A space changed by the rules, with the symbol it had before
+  struct Change
+  {
+    Space* space;
+    char symbol;
+  };
+
+  // An action that changed the game, with what it changed: undoing it puts
+  // back the player's space, steps, offer, state, segment and inventory as
+  // they were and restores the spaces changed from changes onwards
+  struct Turn
+  {
+    Action action;
+    std::size_t changes; // size of changes before the action
+    Space* playerSpace;
+    int steps;
+    Space::Offer offer;
+    Player::State state;
+    int segment;
+    int items;
+    char inventory[Player::INVENTORY_MAX];
+  };
+
+  Board* board;
+  Space* start; // player's starting space
+  bool endless;
+  Player player;
+  int steps; // steps remaining
+  Space::Offer offer;
+  Outcome outcome; // reused by every step to avoid reallocating events
+  std::vector<Change> changes; // spaces to restore on reset
+  std::vector<Turn> history; // actions undo can take back, oldest first
+  std::vector<Action> undone; // actions redo can carry out, latest last
+
+  GameState(const GameState&) = delete;
+  GameState& operator=(const GameState&) = delete;
+
+  void addEvent(Event::Type type, int value);
+  void recordChange(Space* space, char symbol);
+  void play(Action action);
+  void getTurn(Action action, Turn& turn);
+  bool undo();
+  void restoreTurn(const Turn& turn);
+  bool redo();
+  std::vector<std::pair<Space*, char> > changedSpaces();
+  void saveHistory(std::string& out);
+  bool loadHistory(const std::string& in, std::size_t& pos,
+                   std::vector<Turn>& turns, std::vector<Change>& turnChanges);
+
+public:
+  GameState(Board* board, bool endless); // takes ownership of board
+  ~GameState();
+
+  const Outcome& step(Action action);
+  bool reset();
+  Mark getMark();
+  void rollback(const Mark& mark);
+  std::size_t getHistorySize();
+  std::size_t getRedoSize();
+
+  // Saved states, e.g. keyframes in a replay
+  void saveState(std::string& out, bool withHistory);
+  bool loadState(const std::string& in);
+
+  Board* getBoard();
+  Player* getPlayer();
+  int getSteps();
+  Space::Offer getOffer();
+};
+
+#endif
@@ -9,7 +9,8 @@
 #include "holeSpace.hpp"
 #include "player.hpp"
 #include "symbols.hpp"
-#include <iostream>
+#include "memoryStats.hpp"
+#include <cstddef>
 
 // --- Constructor ---
 HoleSpace::HoleSpace()
@@ -24,9 +25,21 @@ HoleSpace::~HoleSpace()
 {
 }
 
+// --- operator new ---
+void* HoleSpace::operator new(std::size_t size)
+{
+  return MemoryStats::allocate(MemoryStats::HOLE_SPACES, size);
+}
+
+// --- operator delete ---
+void HoleSpace::operator delete(void* pointer, std::size_t size)
+{
+  MemoryStats::release(MemoryStats::HOLE_SPACES, pointer, size);
+}
+
 // --- arrive ---
 // Executes upon player arriving in a space
-void HoleSpace::arrive(Player* player)
+void HoleSpace::arrive(Player* player, EventList& events)
 {
   if (defaultSymbol == EMPTY)
   {
@@ -35,19 +48,24 @@ void HoleSpace::arrive(Player* player)
 
   if (player->hasItem(ROCK))
   {
-    std::cout << "You filled the hole in the ground with rocks to cross it.\n";
     player->useItem(ROCK); // remove rock from player inventory
     defaultSymbol = EMPTY; // remove hole from space by changing symbol to empty
+
+    Event filled = { Event::HOLE_FILLED, 0 };
+    events.push_back(filled);
   }
   else
   {
-    std::cout << "\nYou fell in a hole!\n";
     player->setState(Player::LOSE);
+
+    Event fell = { Event::FELL_IN_HOLE, 0 };
+    events.push_back(fell);
   }
 }
 
 // --- inspect ---
 // Executes upon player choosing to inspect current space
-void HoleSpace::inspect(Player* player)
+Space::Offer HoleSpace::inspect(Player* player, EventList& events)
 {
+  return NO_OFFER;
 }
\ No newline at end of file
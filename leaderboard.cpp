@@ -0,0 +1,601 @@
+/*********************************************************************
+** Program name: leaderboard.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Keeps the wins on each map in a log file and ranks each
+** player's best win by the steps it took. Every win is appended to the log as
+** a checksummed record, and the records are synced to disk in batches, so a
+** crash loses at most the batch not yet flushed and never corrupts earlier
+** records. The log is read back into an index per map that answers top-K and
+** rank queries without touching the file. Wins that are no longer anyone's
+** best are dropped by compacting the log, which runs in the background.
+*********************************************************************/
+
+#include "leaderboard.hpp"
+#include "bytes.hpp"
+#include "gameState.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+  const char MAGIC[] = "CAVERANK";
+  const int MAGIC_SIZE = 8;
+  const unsigned VERSION = 1;
+  const int FRAME_SIZE = 4 + 8; // length and checksum before each record
+  const unsigned long long MAX_RECORD = 1 << 16;
+  const long COMPACT_MIN_RECORDS = 4096; // smaller logs are never compacted
+  const int MIN_STEPS_TRACKED = 64; // first size of each map's Fenwick tree
+
+  // Writes what is buffered for file to disk, not just to the system;
+  // returns false on failure
+  bool syncFile(std::FILE* file)
+  {
+    if (std::fflush(file) != 0)
+    {
+      return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+  }
+
+  // Creates a new, empty log at path; returns nullptr on failure
+  std::FILE* startLog(const std::string& path)
+  {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+      return nullptr;
+    }
+
+    std::string header(MAGIC, MAGIC_SIZE);
+    Bytes::putInt(header, VERSION, 4);
+    if (std::fwrite(header.data(), 1, header.length(), file) !=
+        header.length())
+    {
+      std::fclose(file);
+      return nullptr;
+    }
+    return file;
+  }
+
+  // Returns the 64-bit FNV-1a hash of length bytes at data, as
+  // Board::hashMap does for a whole string, used to check each record
+  unsigned long long checksum(const char* data, std::size_t length)
+  {
+    unsigned long long hash = 0xCBF29CE484222325ULL;
+    for (std::size_t i = 0; i < length; i++)
+    {
+      hash ^= static_cast<unsigned char>(data[i]);
+      hash *= 0x100000001B3ULL;
+    }
+    return hash;
+  }
+
+  // Appends text to file; returns false on failure
+  bool writeText(std::FILE* file, const std::string& text)
+  {
+    return std::fwrite(text.data(), 1, text.length(), file) == text.length();
+  }
+}
+
+// --- Constructor ---
+// Makes an empty leaderboard; open reads one from its log
+Leaderboard::Leaderboard()
+{
+  file = nullptr;
+  pendingCount = 0;
+  records = 0;
+  players = 0;
+  logged = 0;
+  compacting = false;
+  compactPendingCount = 0;
+}
+
+// --- Destructor ---
+// Writes the wins not yet written, after any compaction under way finishes
+Leaderboard::~Leaderboard()
+{
+  waitForCompaction();
+  flush();
+  if (file != nullptr)
+  {
+    std::fclose(file);
+  }
+}
+
+// --- open ---
+// Reads the log in filename into the index, creating the log if there is
+// none, and keeps it open to add wins to. A record cut short by a crash, and
+// anything after it, is dropped from the log. Returns false if filename is
+// not a leaderboard log or cannot be written.
+bool Leaderboard::open(const std::string& filename)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  if (file != nullptr)
+  {
+    return false; // already open
+  }
+  this->filename = filename;
+
+  std::string log;
+  std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+  if (in)
+  {
+    log.assign(std::istreambuf_iterator<char>(in),
+               std::istreambuf_iterator<char>());
+  }
+  in.close();
+
+  if (log.empty())
+  {
+    file = startLog(filename);
+    return file != nullptr && syncFile(file);
+  }
+
+  std::size_t pos = MAGIC_SIZE;
+  unsigned long long version;
+  if (log.compare(0, MAGIC_SIZE, MAGIC) != 0 ||
+      !Bytes::getInt(log, pos, 4, version) || version != VERSION)
+  {
+    return false;
+  }
+
+  Entry entry;
+  while (decode(log, pos, entry))
+  {
+    index(entry);
+    records++;
+  }
+
+  if (pos < log.length())
+  {
+    // The last records were never completely written; rewrite the log
+    // without them rather than append after them
+    std::string body;
+    std::vector<Entry> entries = bestEntries();
+    for (std::size_t i = 0; i < entries.size(); i++)
+    {
+      encode(entries[i], body);
+    }
+    std::FILE* replacement = startLog(filename + ".tmp");
+    return replacement != nullptr && writeText(replacement, body) &&
+           replaceLog(replacement, entries.size());
+  }
+
+  file = std::fopen(filename.c_str(), "ab");
+  return file != nullptr;
+}
+
+// --- add ---
+// Adds a win to the log and the index. The win is written to disk with the
+// next batch of BATCH_RECORDS wins, or by flush. Compacts the log in the
+// background once most of it is wins that are no longer anyone's best.
+// Returns false if the win cannot be logged.
+bool Leaderboard::add(const Entry& entry)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  if (file == nullptr || entry.steps < 0 ||
+      entry.steps > GameState::START_STEPS || entry.name.empty())
+  {
+    return false;
+  }
+
+  std::string record;
+  encode(entry, record);
+  if (record.length() > FRAME_SIZE + MAX_RECORD)
+  {
+    return false;
+  }
+
+  pending += record;
+  pendingCount++;
+  records++;
+  if (compacting)
+  {
+    compactPending += record;
+    compactPendingCount++;
+  }
+  index(entry);
+
+  bool written = pendingCount < BATCH_RECORDS || writePending();
+  if (!compacting && records >= COMPACT_MIN_RECORDS && records > 2 * players)
+  {
+    startCompaction();
+  }
+  return written;
+}
+
+// --- flush ---
+// Writes every win added so far to disk; returns false on failure
+bool Leaderboard::flush()
+{
+  std::lock_guard<std::mutex> guard(lock);
+  return writePending();
+}
+
+// --- compact ---
+// Starts rewriting the log in the background with only each player's best
+// win on each map, unless that is already under way. Wins can be added and
+// looked up meanwhile.
+void Leaderboard::compact()
+{
+  std::lock_guard<std::mutex> guard(lock);
+  if (file != nullptr && !compacting)
+  {
+    startCompaction();
+  }
+}
+
+// --- waitForCompaction ---
+// Returns once any compaction under way has finished
+void Leaderboard::waitForCompaction()
+{
+  if (compactor.joinable())
+  {
+    compactor.join();
+  }
+}
+
+// --- index ---
+// Makes entry its player's best win on its map if it takes fewer steps than
+// their best so far; called with lock held
+void Leaderboard::index(const Entry& entry)
+{
+  MapIndex& map = maps[entry.mapHash];
+  unsigned long long number = ++logged;
+
+  std::unordered_map<std::string, Entry>::iterator found =
+    map.best.find(entry.name);
+  if (found != map.best.end())
+  {
+    if (found->second.steps <= entry.steps)
+    {
+      return; // not an improvement
+    }
+
+    // Take the player's old best out of the ranking
+    int oldSteps = found->second.steps;
+    std::map<int, std::map<unsigned long long, std::string> >::iterator
+      level = map.byScore.find(oldSteps);
+    level->second.erase(map.order[entry.name]);
+    if (level->second.empty())
+    {
+      map.byScore.erase(level);
+    }
+    countPlayer(map, oldSteps, -1);
+    found->second = entry;
+  }
+  else
+  {
+    map.best[entry.name] = entry;
+    players++;
+  }
+
+  countPlayer(map, entry.steps, 1);
+  map.byScore[entry.steps][number] = entry.name;
+  map.order[entry.name] = number;
+}
+
+// --- countPlayer ---
+// Adds change to the number of players on map whose best win took steps,
+// growing map's Fenwick tree if it does not reach that far yet; called before
+// the player is added to byScore or after they are taken out
+void Leaderboard::countPlayer(MapIndex& map, int steps, long change)
+{
+  int size = map.counts.size();
+  if (steps + 1 >= size)
+  {
+    int grown = size > 0 ? size - 1 : MIN_STEPS_TRACKED;
+    while (steps + 1 > grown)
+    {
+      grown *= 2;
+    }
+    map.counts.assign(grown + 1, 0);
+    size = grown + 1;
+
+    // Rebuild the tree from the ranking
+    for (std::map<int, std::map<unsigned long long, std::string> >::iterator
+           level = map.byScore.begin();
+         level != map.byScore.end(); ++level)
+    {
+      for (int i = level->first + 1; i < size; i += i & -i)
+      {
+        map.counts[i] += level->second.size();
+      }
+    }
+  }
+
+  for (int i = steps + 1; i < size; i += i & -i)
+  {
+    map.counts[i] += change;
+  }
+}
+
+// --- countBelow ---
+// Returns the number of players on map whose best win took fewer than steps
+long Leaderboard::countBelow(const MapIndex& map, int steps)
+{
+  int size = map.counts.size();
+  long count = 0;
+  for (int i = steps < size ? steps : size - 1; i > 0; i -= i & -i)
+  {
+    count += map.counts[i];
+  }
+  return count;
+}
+
+// --- writePending ---
+// Writes and syncs the wins added since the last time; called with lock held
+bool Leaderboard::writePending()
+{
+  if (pending.empty())
+  {
+    return true;
+  }
+  if (file == nullptr || !writeText(file, pending) || !syncFile(file))
+  {
+    return false;
+  }
+  pending.clear();
+  pendingCount = 0;
+  return true;
+}
+
+// --- bestEntries ---
+// Returns every player's best win on every map, in the order they were
+// logged; called with lock held
+std::vector<Leaderboard::Entry> Leaderboard::bestEntries()
+{
+  std::map<unsigned long long, const Entry*> ordered;
+  for (std::unordered_map<unsigned long long, MapIndex>::iterator map =
+         maps.begin();
+       map != maps.end(); ++map)
+  {
+    for (std::unordered_map<std::string, Entry>::iterator best =
+           map->second.best.begin();
+         best != map->second.best.end(); ++best)
+    {
+      ordered[map->second.order[best->first]] = &best->second;
+    }
+  }
+
+  std::vector<Entry> entries;
+  entries.reserve(ordered.size());
+  for (std::map<unsigned long long, const Entry*>::iterator i =
+         ordered.begin();
+       i != ordered.end(); ++i)
+  {
+    entries.push_back(*i->second);
+  }
+  return entries;
+}
+
+// --- startCompaction ---
+// Starts a thread that compacts the log; called with lock held
+void Leaderboard::startCompaction()
+{
+  waitForCompaction(); // the last one has finished but not been joined
+  compacting = true;
+  compactPending.clear();
+  compactPendingCount = 0;
+  compactor = std::thread(&Leaderboard::compactLog, this, bestEntries());
+}
+
+// --- compactLog ---
+// Writes entries, the best wins when compaction started, to a new log, then
+// adds the wins logged since and puts the new log in place of the old one.
+// Only the last step holds the lock.
+void Leaderboard::compactLog(std::vector<Entry> entries)
+{
+  std::string body;
+  for (std::size_t i = 0; i < entries.size(); i++)
+  {
+    encode(entries[i], body);
+  }
+  std::FILE* replacement = startLog(filename + ".tmp");
+  bool written = replacement != nullptr && writeText(replacement, body);
+
+  std::lock_guard<std::mutex> guard(lock);
+  if (written)
+  {
+    replaceLog(replacement, entries.size());
+  }
+  else if (replacement != nullptr)
+  {
+    std::fclose(replacement);
+  }
+  compacting = false;
+}
+
+// --- replaceLog ---
+// Adds the wins logged during compaction to replacement, a new log holding
+// written records, and renames it over the log; called with lock held.
+// Returns false, keeping the old log, on failure.
+bool Leaderboard::replaceLog(std::FILE* replacement, long written)
+{
+  bool synced = writeText(replacement, compactPending) &&
+                syncFile(replacement);
+  std::fclose(replacement);
+  std::string temporary = filename + ".tmp";
+  if (!synced)
+  {
+    std::remove(temporary.c_str());
+    return false;
+  }
+
+  if (file != nullptr)
+  {
+    std::fclose(file);
+  }
+#ifdef _WIN32
+  std::remove(filename.c_str()); // rename does not replace files here
+#endif
+  bool renamed = std::rename(temporary.c_str(), filename.c_str()) == 0;
+  file = std::fopen(filename.c_str(), "ab");
+  if (renamed)
+  {
+    // Anything pending is in the new log now
+    records = written + compactPendingCount;
+    pending.clear();
+    pendingCount = 0;
+  }
+  else
+  {
+    std::remove(temporary.c_str());
+    if (file != nullptr)
+    {
+      writePending(); // still the old log, which has not got them yet
+    }
+  }
+  compactPending.clear();
+  compactPendingCount = 0;
+  return renamed && file != nullptr;
+}
+
+// --- getRank ---
+// Returns the rank of name's best win on the map with mapHash, where 1 is the
+// fewest steps and players with the same steps share a rank, or 0 if they
+// have not won on it
+long Leaderboard::getRank(unsigned long long mapHash, const std::string& name)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  std::unordered_map<unsigned long long, MapIndex>::iterator map =
+    maps.find(mapHash);
+  if (map == maps.end())
+  {
+    return 0;
+  }
+  std::unordered_map<std::string, Entry>::iterator best =
+    map->second.best.find(name);
+  if (best == map->second.best.end())
+  {
+    return 0;
+  }
+  return countBelow(map->second, best->second.steps) + 1;
+}
+
+// --- getRankOf ---
+// Returns the rank a win taking steps would have on the map with mapHash
+long Leaderboard::getRankOf(unsigned long long mapHash, int steps)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  std::unordered_map<unsigned long long, MapIndex>::iterator map =
+    maps.find(mapHash);
+  return map == maps.end() ? 1 : countBelow(map->second, steps) + 1;
+}
+
+// --- getTop ---
+// Returns up to count of the best wins on the map with mapHash, one per
+// player, best first; of equal wins, the one logged first comes first
+std::vector<Leaderboard::Entry> Leaderboard::getTop(unsigned long long mapHash,
+                                                    std::size_t count)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  std::vector<Entry> top;
+  std::unordered_map<unsigned long long, MapIndex>::iterator map =
+    maps.find(mapHash);
+  if (map == maps.end())
+  {
+    return top;
+  }
+
+  for (std::map<int, std::map<unsigned long long, std::string> >::iterator
+         level = map->second.byScore.begin();
+       level != map->second.byScore.end() && top.size() < count; ++level)
+  {
+    for (std::map<unsigned long long, std::string>::iterator i =
+           level->second.begin();
+         i != level->second.end() && top.size() < count; ++i)
+    {
+      top.push_back(map->second.best[i->second]);
+    }
+  }
+  return top;
+}
+
+// --- getPlayers ---
+// Returns the number of players who have won on the map with mapHash
+long Leaderboard::getPlayers(unsigned long long mapHash)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  std::unordered_map<unsigned long long, MapIndex>::iterator map =
+    maps.find(mapHash);
+  return map == maps.end() ? 0 : map->second.best.size();
+}
+
+// --- getRecords ---
+// Returns the number of wins in the log, including any not yet written
+long Leaderboard::getRecords()
+{
+  std::lock_guard<std::mutex> guard(lock);
+  return records;
+}
+
+// --- encode ---
+// Appends entry to out as a log record: its length and checksum, then the
+// win itself
+void Leaderboard::encode(const Entry& entry, std::string& out)
+{
+  std::string record;
+  Bytes::putInt(record, entry.mapHash, 8);
+  Bytes::putInt(record, entry.steps, 4);
+  Bytes::putInt(record, entry.time, 8);
+  Bytes::putString(record, entry.name);
+  Bytes::putString(record, entry.replay);
+
+  Bytes::putInt(out, record.length(), 4);
+  Bytes::putInt(out, checksum(record.data(), record.length()), 8);
+  out += record;
+}
+
+// --- decode ---
+// Reads a log record written by encode from in at pos into entry and moves
+// pos past it; returns false, leaving pos where it was, if the record is cut
+// short, does not match its checksum or has more steps than a game allows
+bool Leaderboard::decode(const std::string& in, std::size_t& pos,
+                         Entry& entry)
+{
+  std::size_t start = pos;
+  unsigned long long length;
+  unsigned long long sum;
+  if (!Bytes::getInt(in, pos, 4, length) || !Bytes::getInt(in, pos, 8, sum) ||
+      length > MAX_RECORD || pos + length > in.length() ||
+      checksum(in.data() + pos, length) != sum)
+  {
+    pos = start;
+    return false;
+  }
+
+  std::size_t end = pos + length;
+  unsigned long long steps;
+  unsigned long long time;
+  if (!Bytes::getInt(in, pos, 8, entry.mapHash) ||
+      !Bytes::getInt(in, pos, 4, steps) || !Bytes::getInt(in, pos, 8, time) ||
+      !Bytes::getString(in, pos, entry.name) ||
+      !Bytes::getString(in, pos, entry.replay) || pos != end ||
+      steps > static_cast<unsigned long long>(GameState::START_STEPS))
+  {
+    pos = start;
+    return false;
+  }
+  entry.steps = steps;
+  entry.time = time;
+  return true;
+}
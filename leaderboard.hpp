@@ -0,0 +1,99 @@
+/*********************************************************************
+** Program name: leaderboard.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Keeps the wins on each map in a log file and ranks each
+** player's best win by the steps it took. Every win is appended to the log as
+** a checksummed record, and the records are synced to disk in batches, so a
+** crash loses at most the batch not yet flushed and never corrupts earlier
+** records. The log is read back into an index per map that answers top-K and
+** rank queries without touching the file. Wins that are no longer anyone's
+** best are dropped by compacting the log, which runs in the background.
+*********************************************************************/
+
+#ifndef LEADERBOARD_HPP
+#define LEADERBOARD_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class Leaderboard
+{
+public:
+  static const int BATCH_RECORDS = 256; // records written per sync to disk
+
+  // A win on a map
+  struct Entry
+  {
+    unsigned long long mapHash; // from Board::hashMap
+    int steps; // steps used; fewer is better
+    std::string name; // of the player
+    std::string replay; // replay file of the game, if it was recorded
+    long long time; // when it was won, in seconds since 1970
+  };
+
+private:
+  // One map's players, each with their best win
+  struct MapIndex
+  {
+    std::unordered_map<std::string, Entry> best; // by player name
+    // Player names in ranked order: by steps, then by when the win was logged
+    std::map<int, std::map<unsigned long long, std::string> > byScore;
+    std::unordered_map<std::string, unsigned long long> order; // in byScore
+    std::vector<long> counts; // Fenwick tree of players by steps used
+  };
+
+  std::mutex lock; // guards everything below
+  std::string filename;
+  std::FILE* file; // the log, open for appending
+  std::string pending; // records not yet written
+  int pendingCount;
+  long records; // in the log, including pending ones
+  long players; // with a win on some map; a player on two maps counts twice
+  unsigned long long logged; // records ever added, to order ties
+  std::unordered_map<unsigned long long, MapIndex> maps; // by map hash
+
+  std::thread compactor;
+  bool compacting;
+  std::string compactPending; // records added while compacting
+  int compactPendingCount;
+
+  Leaderboard(const Leaderboard&) = delete;
+  Leaderboard& operator=(const Leaderboard&) = delete;
+
+  void index(const Entry& entry);
+  static void countPlayer(MapIndex& map, int steps, long change);
+  static long countBelow(const MapIndex& map, int steps);
+  bool writePending();
+  std::vector<Entry> bestEntries();
+  void startCompaction();
+  void compactLog(std::vector<Entry> entries);
+  bool replaceLog(std::FILE* replacement, long written);
+
+public:
+  Leaderboard();
+  ~Leaderboard();
+
+  bool open(const std::string& filename);
+  bool add(const Entry& entry);
+  bool flush();
+  void compact();
+  void waitForCompaction();
+
+  long getRank(unsigned long long mapHash, const std::string& name);
+  long getRankOf(unsigned long long mapHash, int steps);
+  std::vector<Entry> getTop(unsigned long long mapHash, std::size_t count);
+  long getPlayers(unsigned long long mapHash);
+  long getRecords();
+
+  static void encode(const Entry& entry, std::string& out);
+  static bool decode(const std::string& in, std::size_t& pos, Entry& entry);
+};
+
+#endif
@@ -0,0 +1,146 @@
+/*********************************************************************
+** Program name: levelGenerator.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Creates random candidate maps in the format read by
+** Board::readMap. The same seed always produces the same map.
+*********************************************************************/
+
+#include "levelGenerator.hpp"
+#include "levelSolver.hpp"
+#include "symbols.hpp"
+#include "trace.hpp"
+#include <random>
+#include <string>
+
+// --- Constructor ---
+// Maps smaller than 3x3 have no room inside their walls, so they are enlarged
+LevelGenerator::LevelGenerator(int rows, int cols)
+{
+  this->rows = rows < 3 ? 3 : rows;
+  this->cols = cols < 3 ? 3 : cols;
+
+  wallChance = 0.25;
+  holeChance = 0.15;
+  rockChance = 0.10;
+  picks = 1;
+  walled = true;
+}
+
+// --- getRows ---
+int LevelGenerator::getRows()
+{
+  return rows;
+}
+
+// --- getCols ---
+int LevelGenerator::getCols()
+{
+  return cols;
+}
+
+// --- setChances ---
+void LevelGenerator::setChances(double wall, double hole, double rock)
+{
+  wallChance = wall;
+  holeChance = hole;
+  rockChance = rock;
+}
+
+// --- setPicks ---
+void LevelGenerator::setPicks(int count)
+{
+  picks = count < 0 ? 0 : count;
+}
+
+// --- setWalled ---
+// Sets whether the edge of the map is solid wall; unwalled maps are random up
+// to their edges so that they can be placed side by side
+void LevelGenerator::setWalled(bool status)
+{
+  walled = status;
+}
+
+// --- generate ---
+// Surrounds the map with walls (if walled), fills the interior at random, then
+// places the pickaxes and the exit on empty spaces. The player's start at
+// [1,1] is always left empty. Stops adding holes, rocks and picks once LevelSolver::MAX_TILES
+// have been placed so that every map can be searched.
+std::string LevelGenerator::generate(unsigned long long seed)
+{
+  Trace::Scope scope("generate", "generator");
+  std::mt19937_64 random(seed);
+  std::uniform_real_distribution<double> chance(0.0, 1.0);
+  int edge = walled ? 1 : 0; // width of the wall around the map
+  std::uniform_int_distribution<int> randomRow(edge, rows - 1 - edge);
+  std::uniform_int_distribution<int> randomCol(edge, cols - 1 - edge);
+
+  std::string map(rows * cols, WALL);
+  int start = cols + 1;
+  int tiles = 0;
+
+  for (int i = edge; i < rows - edge; i++)
+  {
+    for (int j = edge; j < cols - edge; j++)
+    {
+      double roll = chance(random);
+      char type = EMPTY;
+
+      if (roll < wallChance)
+      {
+        type = WALL;
+      }
+      else if (roll < wallChance + holeChance)
+      {
+        type = HOLE;
+      }
+      else if (roll < wallChance + holeChance + rockChance)
+      {
+        type = ROCK;
+      }
+
+      if ((type == HOLE || type == ROCK) && tiles >= LevelSolver::MAX_TILES)
+      {
+        type = EMPTY;
+      }
+      else if (type == HOLE || type == ROCK)
+      {
+        tiles++;
+      }
+
+      map[i * cols + j] = type;
+    }
+  }
+  map[start] = EMPTY;
+
+  // Pickaxes and the exit go on spaces that are not already in use; give up
+  // after a bounded number of tries on a crowded map
+  int attempts = rows * cols * 4;
+  for (int placed = 0; placed < picks && attempts > 0; attempts--)
+  {
+    int cell = randomRow(random) * cols + randomCol(random);
+    if (cell != start && map[cell] != PICK && map[cell] != HOLE &&
+        map[cell] != ROCK && tiles < LevelSolver::MAX_TILES)
+    {
+      map[cell] = PICK;
+      tiles++;
+      placed++;
+    }
+  }
+
+  for (attempts = rows * cols * 4; attempts > 0; attempts--)
+  {
+    int cell = randomRow(random) * cols + randomCol(random);
+    if (cell != start && map[cell] != PICK)
+    {
+      if (map[cell] == HOLE || map[cell] == ROCK)
+      {
+        tiles--;
+      }
+      map[cell] = EXIT;
+      break;
+    }
+  }
+
+  return map;
+}
@@ -0,0 +1,41 @@
+/*********************************************************************
+** Program name: levelGenerator.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Creates random candidate maps in the format read by
+** Board::readMap. The same seed always produces the same map.
+*********************************************************************/
+
+#ifndef LEVELGENERATOR_HPP
+#define LEVELGENERATOR_HPP
+
+#include <string>
+
+class LevelGenerator
+{
+private:
+  int rows;
+  int cols;
+
+  // Chance of each interior space being a wall, hole or rock
+  double wallChance;
+  double holeChance;
+  double rockChance;
+
+  int picks; // number of pickaxes placed on every map
+  bool walled; // surround the map with walls; false for endless cave chunks
+
+public:
+  LevelGenerator(int rows, int cols);
+
+  int getRows();
+  int getCols();
+
+  void setChances(double wall, double hole, double rock);
+  void setPicks(int count);
+  void setWalled(bool status);
+
+  std::string generate(unsigned long long seed);
+};
+
+#endif
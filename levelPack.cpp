@@ -0,0 +1,178 @@
+/*********************************************************************
+** Program name: levelPack.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Reads and writes level packs: a single binary file holding
+** many maps, with an index at the front so any one level can be loaded
+** without reading the others.
+**
+** File layout, all integers little-endian:
+**   "CAVEPACK"  8-byte magic
+**   u32         format version
+**   u32         number of levels
+**   per level:  u64 map offset, u64 seed, u32 rows, u32 cols,
+**               u16 optimal steps, u16 difficulty
+**   map data:   rows * cols bytes per level, at the offsets above
+*********************************************************************/
+
+#include "levelPack.hpp"
+#include "bytes.hpp"
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  const char MAGIC[] = "CAVEPACK";
+  const int MAGIC_SIZE = 8;
+  const unsigned VERSION = 1;
+  const int HEADER_SIZE = MAGIC_SIZE + 4 + 4;
+  const int ENTRY_SIZE = 8 + 8 + 4 + 4 + 2 + 2;
+  const unsigned long long MAX_SIDE = 1 << 15; // rows or columns in a level
+
+  // Appends the next count bytes of in to text; returns false if in ends
+  // first
+  bool readMore(std::ifstream& in, std::string& text, std::size_t count)
+  {
+    std::size_t length = text.length();
+    text.resize(length + count);
+    if (count > 0)
+    {
+      in.read(&text[length], count);
+    }
+    return static_cast<bool>(in);
+  }
+}
+
+// --- save ---
+// Writes levels to filename as a new level pack; returns false on failure
+bool LevelPack::save(const std::string& filename,
+                     const std::vector<Level>& levels)
+{
+  std::string header(MAGIC, MAGIC_SIZE);
+  Bytes::putInt(header, VERSION, 4);
+  Bytes::putInt(header, levels.size(), 4);
+
+  unsigned long long offset = HEADER_SIZE + ENTRY_SIZE * levels.size();
+  for (std::vector<Level>::const_iterator i = levels.begin();
+       i != levels.end(); i++)
+  {
+    Bytes::putInt(header, offset, 8);
+    Bytes::putInt(header, i->seed, 8);
+    Bytes::putInt(header, i->rows, 4);
+    Bytes::putInt(header, i->cols, 4);
+    Bytes::putInt(header, i->steps, 2);
+    Bytes::putInt(header, i->difficulty, 2);
+    offset += i->map.length();
+  }
+
+  std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+  if (!out)
+  {
+    return false;
+  }
+  out.write(header.data(), header.length());
+  for (std::vector<Level>::const_iterator i = levels.begin();
+       i != levels.end(); i++)
+  {
+    out.write(i->map.data(), i->map.length());
+  }
+
+  return static_cast<bool>(out);
+}
+
+// --- open ---
+// Reads the index of an existing level pack; maps are read on demand by
+// getLevel. Returns false if the file is missing or not a level pack.
+bool LevelPack::open(const std::string& filename)
+{
+  index.clear();
+  if (packFile.is_open())
+  {
+    packFile.close();
+  }
+
+  packFile.open(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!packFile)
+  {
+    return false;
+  }
+
+  packFile.seekg(0, std::ios::end);
+  unsigned long long fileSize = packFile.tellg();
+  packFile.seekg(0);
+
+  // Every level's size must be sane and its map must lie within the file
+  std::string header;
+  std::size_t pos = MAGIC_SIZE;
+  unsigned long long version;
+  unsigned long long count = 0;
+  bool valid = readMore(packFile, header, HEADER_SIZE) &&
+               header.compare(0, MAGIC_SIZE, MAGIC) == 0 &&
+               Bytes::getInt(header, pos, 4, version) && version == VERSION &&
+               Bytes::getInt(header, pos, 4, count) &&
+               count <= fileSize / ENTRY_SIZE &&
+               readMore(packFile, header, count * ENTRY_SIZE);
+  for (unsigned long long i = 0; valid && i < count; i++)
+  {
+    Entry entry;
+    unsigned long long seed;
+    unsigned long long rows;
+    unsigned long long cols;
+    unsigned long long steps;
+    unsigned long long difficulty;
+    Bytes::getInt(header, pos, 8, entry.offset);
+    Bytes::getInt(header, pos, 8, seed);
+    Bytes::getInt(header, pos, 4, rows);
+    Bytes::getInt(header, pos, 4, cols);
+    Bytes::getInt(header, pos, 2, steps);
+    Bytes::getInt(header, pos, 2, difficulty);
+
+    valid = rows > 0 && rows <= MAX_SIDE && cols > 0 && cols <= MAX_SIDE &&
+            entry.offset <= fileSize && rows * cols <= fileSize - entry.offset;
+    entry.info.seed = seed;
+    entry.info.rows = rows;
+    entry.info.cols = cols;
+    entry.info.steps = steps;
+    entry.info.difficulty = difficulty;
+    index.push_back(entry);
+  }
+
+  if (!valid)
+  {
+    index.clear();
+    packFile.close();
+    return false;
+  }
+
+  return true;
+}
+
+// --- size ---
+// Returns the number of levels in the open pack
+int LevelPack::size()
+{
+  return index.size();
+}
+
+// --- getLevel ---
+// Loads level number (starting at 0) from the open pack into level; returns
+// false if there is no such level
+bool LevelPack::getLevel(int number, Level& level)
+{
+  if (number < 0 || number >= size())
+  {
+    return false;
+  }
+
+  const Entry& entry = index[number];
+  level = entry.info;
+  level.map.assign(level.rows * level.cols, ' ');
+
+  packFile.clear();
+  packFile.seekg(entry.offset);
+  packFile.read(&level.map[0], level.map.length());
+
+  return static_cast<bool>(packFile);
+}
@@ -0,0 +1,50 @@
+/*********************************************************************
+** Program name: levelPack.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Reads and writes level packs: a single binary file holding
+** many maps, with an index at the front so any one level can be loaded
+** without reading the others.
+*********************************************************************/
+
+#ifndef LEVELPACK_HPP
+#define LEVELPACK_HPP
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+class LevelPack
+{
+public:
+  struct Level
+  {
+    int rows;
+    int cols;
+    int steps; // moves in the level's optimal solution
+    int difficulty;
+    unsigned long long seed; // seed the level was generated from
+    std::string map; // rows * cols symbols, row by row
+  };
+
+private:
+  // Index entry for one level; map data is stored at offset in the file
+  struct Entry
+  {
+    unsigned long long offset;
+    Level info; // everything except the map itself
+  };
+
+  std::vector<Entry> index;
+  std::ifstream packFile;
+
+public:
+  static bool save(const std::string& filename,
+                   const std::vector<Level>& levels);
+
+  bool open(const std::string& filename);
+  int size();
+  bool getLevel(int number, Level& level);
+};
+
+#endif
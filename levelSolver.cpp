@@ -0,0 +1,466 @@
+/*********************************************************************
+** Program name: levelSolver.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Finds the shortest winning sequence of moves for a map using
+** the same rules as the game: walls block movement, holes end the game unless
+** the player carries a rock to fill them, rocks can be mined while carrying a
+** pickaxe, and the inventory holds at most Player::INVENTORY_MAX items.
+** Maps of the sizes levels are usually made in are searched on a FixedBoard,
+** whose size is known at compile time; others on a MapGrid.
+*********************************************************************/
+
+#include "levelSolver.hpp"
+#include "fixedBoard.hpp"
+#include "player.hpp"
+#include "symbols.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+  // A search node: the player's cell and inventory, plus one bit for every
+  // hole that has been filled, rock that has been mined or pick that has been
+  // taken. Everything else about the board is fixed by the map.
+  struct Node
+  {
+    std::uint32_t cell;
+    std::uint8_t picks;
+    std::uint8_t rocks;
+    std::uint64_t mask;
+
+    bool operator==(const Node& other) const
+    {
+      return cell == other.cell && picks == other.picks &&
+             rocks == other.rocks && mask == other.mask;
+    }
+  };
+
+  struct NodeHash
+  {
+    std::size_t operator()(const Node& node) const
+    {
+      std::uint64_t h = node.mask * 0x9E3779B97F4A7C15ULL;
+      h ^= (static_cast<std::uint64_t>(node.cell) << 4) | (node.picks << 2) |
+           node.rocks;
+      h *= 0xC2B2AE3D27D4EB4FULL;
+      return static_cast<std::size_t>(h ^ (h >> 29));
+    }
+  };
+
+  struct Visit
+  {
+    int steps;
+    Node parent;
+    char action; // action taken from parent to reach this node
+  };
+
+  const char DIRECTIONS[] = { 'W', 'A', 'S', 'D' };
+
+  // A map searched as it is, for sizes no FixedBoard is built for; has the
+  // same methods as FixedBoard
+  class MapGrid
+  {
+  private:
+    const std::string& map;
+    int rows;
+    int cols;
+
+  public:
+    MapGrid(const std::string& map, int rows, int cols)
+      : map(map), rows(rows), cols(cols)
+    {
+    }
+
+    char symbol(int cell) const
+    {
+      return map[cell];
+    }
+
+    // Returns the cell reached by moving one space in direction (W, A, S or
+    // D) from cell, or -1 if the edge of the map or a wall is in the way
+    int move(int cell, char direction) const
+    {
+      int row = cell / cols;
+      int col = cell % cols;
+      int target = -1;
+
+      switch (direction)
+      {
+        case 'W':
+          target = row > 0 ? cell - cols : -1;
+          break;
+        case 'A':
+          target = col > 0 ? cell - 1 : -1;
+          break;
+        case 'S':
+          target = row < rows - 1 ? cell + cols : -1;
+          break;
+        case 'D':
+          target = col < cols - 1 ? cell + 1 : -1;
+          break;
+      }
+      return target >= 0 && map[target] != WALL ? target : -1;
+    }
+  };
+}
+
+// --- Constructor ---
+// Takes a map in the same row-major format Board::readMap produces
+LevelSolver::LevelSolver(const std::string& map, int rows, int cols)
+{
+  this->map = map;
+  this->rows = rows;
+  this->cols = cols;
+  start = cols + 1;
+  exitCount = 0;
+
+  tileBit.assign(map.length(), -1);
+  int bits = 0;
+  for (int i = 0, n = map.length(); i < n; i++)
+  {
+    char type = map[i];
+    if (type == HOLE || type == ROCK || type == PICK)
+    {
+      tileBit[i] = bits < MAX_TILES ? bits : -1;
+      bits++;
+    }
+    else if (type == EXIT)
+    {
+      exitCount++;
+    }
+  }
+}
+
+// --- countTiles ---
+int LevelSolver::countTiles(char type)
+{
+  return std::count(map.begin(), map.end(), type);
+}
+
+// --- interactiveTiles ---
+// Returns the number of holes, rocks and picks on the map; maps with more than
+// MAX_TILES of them cannot be solved
+int LevelSolver::interactiveTiles()
+{
+  return countTiles(HOLE) + countTiles(ROCK) + countTiles(PICK);
+}
+
+// --- hasExit ---
+bool LevelSolver::hasExit()
+{
+  return exitCount > 0;
+}
+
+// --- solve ---
+// Searches every reachable game state in order of steps taken, treating
+// inspecting as free and moving as one step, and returns the first winning
+// sequence found. Gives up after maxStates states if maxStates is positive.
+LevelSolver::Result LevelSolver::solve(int maxSteps, long maxStates)
+{
+  Trace::Scope scope("solve", "solver");
+  if (rows == 7 && cols == 7)
+  {
+    return search(FixedBoard<7, 7>(map), maxSteps, maxStates);
+  }
+  else if (rows == 16 && cols == 16)
+  {
+    return search(FixedBoard<16, 16>(map), maxSteps, maxStates);
+  }
+  else if (rows == 32 && cols == 32)
+  {
+    return search(FixedBoard<32, 32>(map), maxSteps, maxStates);
+  }
+  return search(MapGrid(map, rows, cols), maxSteps, maxStates);
+}
+
+// --- search ---
+// Carries out solve on grid, the map as a FixedBoard or MapGrid
+template <typename Grid>
+LevelSolver::Result LevelSolver::search(const Grid& grid, int maxSteps,
+                                        long maxStates)
+{
+  Result result;
+  result.solved = false;
+  result.aborted = false;
+  result.steps = 0;
+  result.picksTaken = 0;
+  result.rocksMined = 0;
+  result.holesFilled = 0;
+  result.statesVisited = 0;
+
+  if (rows < 2 || cols < 2 || map[start] == WALL ||
+      interactiveTiles() > MAX_TILES)
+  {
+    return result;
+  }
+
+  std::unordered_map<Node, Visit, NodeHash> visited;
+  std::deque<std::pair<Node, int> > open; // 0-1 BFS frontier
+
+  Node first = { static_cast<std::uint32_t>(start), 0, 0, 0 };
+  Visit firstVisit = { 0, first, 0 };
+  visited[first] = firstVisit;
+  open.push_back(std::make_pair(first, 0));
+
+  bool found = false;
+  Node goal = first;
+
+  while (!open.empty() && !found)
+  {
+    Node node = open.front().first;
+    int steps = open.front().second;
+    open.pop_front();
+
+    if (visited[node].steps < steps)
+    {
+      continue; // stale entry; node was reached more cheaply since
+    }
+
+    if (maxStates > 0 && static_cast<long>(visited.size()) > maxStates)
+    {
+      result.aborted = true;
+      break;
+    }
+
+    int cell = node.cell;
+    int inventory = node.picks + node.rocks;
+
+    // Inspecting costs no steps, so its results go to the front of the queue
+    int bit = tileBit[cell];
+    if (bit >= 0 && !(node.mask >> bit & 1) &&
+        inventory < Player::INVENTORY_MAX)
+    {
+      Node next = node;
+      bool offered = false;
+
+      if (grid.symbol(cell) == PICK)
+      {
+        next.picks++;
+        offered = true;
+      }
+      else if (grid.symbol(cell) == ROCK && node.picks > 0)
+      {
+        next.rocks++;
+        offered = true;
+      }
+
+      if (offered)
+      {
+        next.mask |= 1ULL << bit;
+        std::unordered_map<Node, Visit, NodeHash>::iterator existing =
+          visited.find(next);
+        if (existing == visited.end() || existing->second.steps > steps)
+        {
+          Visit visit = { steps, node, 'E' };
+          visited[next] = visit;
+          open.push_front(std::make_pair(next, steps));
+        }
+      }
+    }
+
+    if (steps >= maxSteps)
+    {
+      continue; // out of steps; moving again would lose the game
+    }
+
+    for (int d = 0; d < 4 && !found; d++)
+    {
+      int target = grid.move(cell, DIRECTIONS[d]);
+      if (target < 0)
+      {
+        continue;
+      }
+
+      Node next = node;
+      next.cell = target;
+
+      char type = grid.symbol(target);
+      int targetBit = tileBit[target];
+      if (type == HOLE && !(node.mask >> targetBit & 1))
+      {
+        if (node.rocks == 0)
+        {
+          continue; // player would fall in
+        }
+        next.rocks--;
+        next.mask |= 1ULL << targetBit;
+      }
+
+      if (visited.find(next) != visited.end())
+      {
+        continue; // any earlier visit was at most as many steps away
+      }
+
+      Visit visit = { steps + 1, node, DIRECTIONS[d] };
+      visited[next] = visit;
+
+      if (type == EXIT)
+      {
+        found = true; // arriving at the exit ends the game, so don't expand
+        goal = next;
+      }
+      else
+      {
+        open.push_back(std::make_pair(next, steps + 1));
+      }
+    }
+  }
+
+  result.statesVisited = visited.size();
+  if (!found)
+  {
+    return result;
+  }
+
+  // Walk back from the exit to recover the winning moves
+  result.solved = true;
+  result.steps = visited[goal].steps;
+
+  Node current = goal;
+  while (!(current == first))
+  {
+    const Visit& visit = visited[current];
+    result.moves += visit.action;
+
+    if (visit.action == 'E')
+    {
+      if (map[current.cell] == PICK)
+      {
+        result.picksTaken++;
+      }
+      else
+      {
+        result.rocksMined++;
+      }
+    }
+    else if (current.mask != visit.parent.mask)
+    {
+      result.holesFilled++;
+    }
+
+    current = visit.parent;
+  }
+  std::reverse(result.moves.begin(), result.moves.end());
+
+  return result;
+}
+
+// --- solvableWithoutItems ---
+// Returns true if the exit can be reached within maxSteps without stepping on
+// a single hole, i.e. the map does not require any items to solve
+bool LevelSolver::solvableWithoutItems(int maxSteps)
+{
+  Trace::Scope scope("solve without items", "solver");
+  if (rows < 2 || cols < 2 || map[start] == WALL)
+  {
+    return false;
+  }
+
+  // A FixedBoard floods a row of spaces at a time
+  if (rows == 7 && cols == 7)
+  {
+    return FixedBoard<7, 7>(map).exitWithin(start, maxSteps);
+  }
+  else if (rows == 16 && cols == 16)
+  {
+    return FixedBoard<16, 16>(map).exitWithin(start, maxSteps);
+  }
+  else if (rows == 32 && cols == 32)
+  {
+    return FixedBoard<32, 32>(map).exitWithin(start, maxSteps);
+  }
+
+  MapGrid grid(map, rows, cols);
+
+  std::vector<int> distance(map.length(), -1);
+  std::deque<int> open;
+  distance[start] = 0;
+  open.push_back(start);
+
+  while (!open.empty())
+  {
+    int cell = open.front();
+    open.pop_front();
+
+    if (grid.symbol(cell) == EXIT)
+    {
+      return true;
+    }
+    if (distance[cell] >= maxSteps)
+    {
+      continue;
+    }
+
+    for (int d = 0; d < 4; d++)
+    {
+      int target = grid.move(cell, DIRECTIONS[d]);
+      if (target >= 0 && distance[target] < 0 && grid.symbol(target) != HOLE)
+      {
+        distance[target] = distance[cell] + 1;
+        open.push_back(target);
+      }
+    }
+  }
+
+  return false;
+}
+
+// --- difficulty ---
+// Scores a solved map: longer solutions, more item interactions, more holes
+// brushed past along the way and a larger search all make a map harder
+int LevelSolver::difficulty(const Result& result)
+{
+  Trace::Scope scope("difficulty", "solver");
+  if (!result.solved)
+  {
+    return 0;
+  }
+
+  int interactions = result.picksTaken + result.rocksMined + result.holesFilled;
+  MapGrid grid(map, rows, cols);
+
+  // Count holes beside the solution path that a wrong move would fall into
+  std::vector<bool> onPath(map.length(), false);
+  int cell = start;
+  onPath[cell] = true;
+  for (int i = 0, n = result.moves.length(); i < n; i++)
+  {
+    if (result.moves[i] != 'E')
+    {
+      cell = grid.move(cell, result.moves[i]);
+      onPath[cell] = true;
+    }
+  }
+
+  int nearHoles = 0;
+  for (int i = 0, n = map.length(); i < n; i++)
+  {
+    if (map[i] != HOLE || onPath[i])
+    {
+      continue;
+    }
+    for (int d = 0; d < 4; d++)
+    {
+      int neighbour = grid.move(i, DIRECTIONS[d]);
+      if (neighbour >= 0 && onPath[neighbour])
+      {
+        nearHoles++;
+        break;
+      }
+    }
+  }
+
+  int searchSize = 0; // log2 of the number of states searched
+  for (long states = result.statesVisited; states > 1; states >>= 1)
+  {
+    searchSize++;
+  }
+
+  return result.steps + 3 * interactions + nearHoles + searchSize;
+}
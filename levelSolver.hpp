@@ -0,0 +1,59 @@
+/*********************************************************************
+** Program name: levelSolver.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Finds the shortest winning sequence of moves for a map using
+** the same rules as the game: walls block movement, holes end the game unless
+** the player carries a rock to fill them, rocks can be mined while carrying a
+** pickaxe, and the inventory holds at most Player::INVENTORY_MAX items.
+*********************************************************************/
+
+#ifndef LEVELSOLVER_HPP
+#define LEVELSOLVER_HPP
+
+#include <string>
+#include <vector>
+
+class LevelSolver
+{
+public:
+  static const int MAX_TILES = 64; // holes, rocks and picks tracked per map
+
+  struct Result
+  {
+    bool solved; // true if the exit can be reached within the step limit
+    bool aborted; // true if the search gave up after too many states
+    int steps; // moves taken by the optimal solution
+    int picksTaken;
+    int rocksMined;
+    int holesFilled;
+    long statesVisited;
+    std::string moves; // W/A/S/D to move, E to inspect and accept the offer
+  };
+
+private:
+  std::string map;
+  int rows;
+  int cols;
+  int start; // cell the player starts on, i.e. [1,1]
+  int exitCount;
+
+  std::vector<int> tileBit; // bit of each hole, rock or pick cell; -1 if none
+
+  // Searches on grid, a FixedBoard if one fits the map and a MapGrid if not
+  template <typename Grid>
+  Result search(const Grid& grid, int maxSteps, long maxStates);
+
+public:
+  LevelSolver(const std::string& map, int rows, int cols);
+
+  int countTiles(char type);
+  int interactiveTiles();
+  bool hasExit();
+
+  Result solve(int maxSteps, long maxStates);
+  bool solvableWithoutItems(int maxSteps);
+  int difficulty(const Result& result);
+};
+
+#endif
@@ -0,0 +1,503 @@
+/*********************************************************************
+** Program name: levelgen.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Generates a pack of verified-solvable levels. Candidate maps
+** pass through four concurrent stages connected by bounded queues:
+**   generate - random maps from consecutive seeds
+**   validate - cheap checks: an exit, every item type, and no route to the
+**              exit that avoids the holes
+**   solve    - full search; the optimal solution must fall within the
+**              requested step range and take a pickaxe, mine a rock and fill
+**              a hole along the way
+**   score    - difficulty rating for each accepted level
+** The pack holds the accepted levels of the lowest seeds, in seed order, so
+** it is the same whatever the thread timing. It is written as an indexed
+** level pack, and the throughput of every stage is reported so the slowest
+** one can be found. With -check, an existing pack is read back instead and
+** every level in it is solved again.
+**
+** Usage: levelgen [-n count] [-min steps] [-max steps] [-rows n] [-cols n]
+**                 [-seed n] [-threads n] [-limit candidates] [-o file]
+**                 [-trace file]
+**        levelgen -check file
+*********************************************************************/
+
+#include "levelGenerator.hpp"
+#include "levelSolver.hpp"
+#include "levelPack.hpp"
+#include "workQueue.hpp"
+#include "gameState.hpp"
+#include "symbols.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  typedef std::chrono::steady_clock Clock;
+
+  const long MAX_SEARCH_STATES = 2000000; // per candidate map
+  const std::size_t QUEUE_SIZE = 256;
+
+  // A map moving through the pipeline
+  struct Candidate
+  {
+    unsigned long long seed;
+    std::string map;
+    LevelSolver::Result result;
+    int difficulty;
+  };
+
+  // Counters for one stage, shared by all of its worker threads
+  struct Stage
+  {
+    const char* name;
+    int workers;
+    std::atomic<long> processed;
+    std::atomic<long> passed;
+    std::atomic<long long> busyNanos;
+  };
+
+  struct Settings
+  {
+    int count;
+    int minSteps;
+    int maxSteps;
+    int rows;
+    int cols;
+    unsigned long long seed;
+    int threads;
+    long limit; // most candidate maps to try before giving up
+    std::string filename;
+    std::string traceFilename; // where to write a trace; empty for none
+    std::string checkFilename; // pack to check instead of generating one
+  };
+
+  // Adds the time since started to stage's busy total
+  void addBusyTime(Stage& stage, Clock::time_point started)
+  {
+    stage.busyNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+      Clock::now() - started).count();
+  }
+
+  // Reads the command line into settings; returns false on a bad argument
+  bool readArgs(int argc, char* argv[], Settings& settings)
+  {
+    for (int i = 1; i < argc; i++)
+    {
+      std::string flag = argv[i];
+      if (i + 1 >= argc)
+      {
+        return false;
+      }
+      std::string value = argv[++i];
+
+      if (flag == "-n")
+      {
+        settings.count = std::atoi(value.c_str());
+      }
+      else if (flag == "-min")
+      {
+        settings.minSteps = std::atoi(value.c_str());
+      }
+      else if (flag == "-max")
+      {
+        settings.maxSteps = std::atoi(value.c_str());
+      }
+      else if (flag == "-rows")
+      {
+        settings.rows = std::atoi(value.c_str());
+      }
+      else if (flag == "-cols")
+      {
+        settings.cols = std::atoi(value.c_str());
+      }
+      else if (flag == "-seed")
+      {
+        settings.seed = std::strtoull(value.c_str(), nullptr, 10);
+      }
+      else if (flag == "-threads")
+      {
+        settings.threads = std::atoi(value.c_str());
+      }
+      else if (flag == "-limit")
+      {
+        settings.limit = std::atol(value.c_str());
+      }
+      else if (flag == "-o")
+      {
+        settings.filename = value;
+      }
+      else if (flag == "-trace")
+      {
+        settings.traceFilename = value;
+      }
+      else if (flag == "-check")
+      {
+        settings.checkFilename = value;
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    return settings.count > 0 && settings.minSteps <= settings.maxSteps &&
+           settings.maxSteps > 0 &&
+           settings.maxSteps <= GameState::START_STEPS &&
+           settings.threads > 0 &&
+           settings.limit >= 0;
+  }
+
+  // Reads every level of the pack in filename and solves it again; returns
+  // false if the pack cannot be read or any level is not the one recorded
+  bool checkPack(const std::string& filename)
+  {
+    LevelPack pack;
+    if (!pack.open(filename))
+    {
+      std::cout << "Could not read level pack " << filename << "\n";
+      return false;
+    }
+
+    int bad = 0;
+    for (int i = 0; i < pack.size(); i++)
+    {
+      LevelPack::Level level;
+      bool valid = pack.getLevel(i, level);
+      if (valid)
+      {
+        LevelSolver solver(level.map, level.rows, level.cols);
+        LevelSolver::Result result = solver.solve(GameState::START_STEPS,
+                                                  MAX_SEARCH_STATES);
+        valid = result.solved && result.steps == level.steps &&
+                solver.difficulty(result) == level.difficulty;
+      }
+
+      if (!valid)
+      {
+        std::cout << "Level " << i << " (seed " << level.seed
+                  << ") does not match its recorded solution\n";
+        bad++;
+      }
+    }
+
+    std::cout << "Checked " << pack.size() << " levels in " << filename
+              << ": " << bad << " bad\n";
+    return bad == 0;
+  }
+
+  // Prints per-stage throughput; the stage with the highest utilization is the
+  // bottleneck of the pipeline
+  void printReport(Stage* stages[], int stageCount, double seconds)
+  {
+    std::cout << "\n"
+              << std::left << std::setw(10) << "stage"
+              << std::right << std::setw(8) << "workers"
+              << std::setw(12) << "processed"
+              << std::setw(10) << "passed"
+              << std::setw(14) << "levels/sec"
+              << std::setw(18) << "per worker/sec"
+              << std::setw(8) << "busy" << "\n";
+
+    for (int i = 0; i < stageCount; i++)
+    {
+      Stage& stage = *stages[i];
+      double busy = stage.busyNanos / 1e9;
+      double perWorker = busy > 0 ? stage.processed / busy : 0;
+      double utilization = seconds > 0 ? busy / (seconds * stage.workers) : 0;
+
+      std::cout << std::left << std::setw(10) << stage.name
+                << std::right << std::setw(8) << stage.workers
+                << std::setw(12) << stage.processed
+                << std::setw(10) << stage.passed
+                << std::setw(14) << std::fixed << std::setprecision(1)
+                << (seconds > 0 ? stage.processed / seconds : 0)
+                << std::setw(18) << perWorker
+                << std::setw(7) << std::setprecision(0)
+                << utilization * 100 << "%\n";
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  Settings settings;
+  settings.count = 100;
+  settings.minSteps = 10;
+  settings.maxSteps = GameState::START_STEPS;
+  settings.rows = 7;
+  settings.cols = 7;
+  settings.seed = 1;
+  settings.threads = std::thread::hardware_concurrency();
+  settings.filename = "levels.pack";
+  settings.limit = 0;
+  if (settings.threads < 1)
+  {
+    settings.threads = 1;
+  }
+
+  if (!readArgs(argc, argv, settings))
+  {
+    std::cout << "Usage: levelgen [-n count] [-min steps] [-max steps] "
+              << "[-rows n] [-cols n] [-seed n] [-threads n] "
+              << "[-limit candidates] [-o file] [-trace file]\n"
+              << "       levelgen -check file\n";
+    return 1;
+  }
+
+  if (!settings.checkFilename.empty())
+  {
+    return checkPack(settings.checkFilename) ? 0 : 1;
+  }
+
+  if (!settings.traceFilename.empty() && !Trace::start(settings.traceFilename))
+  {
+    std::cout << "Could not write " << settings.traceFilename << "\n";
+    return 1;
+  }
+  Trace::nameThread("main");
+
+  if (settings.limit == 0)
+  {
+    settings.limit = settings.count * 10000L;
+  }
+
+  LevelGenerator generator(settings.rows, settings.cols);
+  int rows = generator.getRows();
+  int cols = generator.getCols();
+
+  // The solver does nearly all the work, so it gets every spare core
+  Stage generateStage = { "generate", 1, {0}, {0}, {0} };
+  Stage validateStage = { "validate", 1, {0}, {0}, {0} };
+  Stage solveStage = { "solve", std::max(1, settings.threads - 3), {0}, {0},
+                       {0} };
+  Stage scoreStage = { "score", 1, {0}, {0}, {0} };
+  Stage* stages[] = { &generateStage, &validateStage, &solveStage, &scoreStage };
+
+  WorkQueue<Candidate> toValidate(QUEUE_SIZE);
+  WorkQueue<Candidate> toSolve(QUEUE_SIZE);
+  WorkQueue<Candidate> toScore(QUEUE_SIZE);
+  WorkQueue<Candidate> accepted(QUEUE_SIZE);
+  std::atomic<bool> done(false);
+
+  // Seeds whose candidates have been rejected or collected: every seed below
+  // resolvedBelow, and those in resolvedAhead
+  std::mutex resolvedLock;
+  unsigned long long resolvedBelow = settings.seed;
+  std::set<unsigned long long> resolvedAhead;
+  auto resolve = [&](unsigned long long seed)
+  {
+    std::lock_guard<std::mutex> guard(resolvedLock);
+    resolvedAhead.insert(seed);
+    while (!resolvedAhead.empty() && *resolvedAhead.begin() == resolvedBelow)
+    {
+      resolvedAhead.erase(resolvedAhead.begin());
+      resolvedBelow++;
+    }
+  };
+  std::atomic<int> solversLeft(solveStage.workers);
+
+  Clock::time_point started = Clock::now();
+  std::vector<std::thread> threads;
+
+  // Generate: one map per seed until enough levels have been accepted or the
+  // candidate limit is reached
+  threads.push_back(std::thread([&]()
+  {
+    Trace::nameThread("generate");
+    for (long tried = 0; !done && tried < settings.limit; tried++)
+    {
+      unsigned long long seed = settings.seed + tried;
+      Clock::time_point begin = Clock::now();
+      Candidate candidate;
+      candidate.seed = seed;
+      candidate.map = generator.generate(seed);
+      candidate.difficulty = 0;
+      generateStage.processed++;
+      generateStage.passed++;
+      addBusyTime(generateStage, begin);
+
+      if (!toValidate.push(candidate))
+      {
+        break;
+      }
+    }
+    toValidate.close();
+  }));
+
+  // Validate: reject maps that are broken or can be won without items
+  threads.push_back(std::thread([&]()
+  {
+    Trace::nameThread("validate");
+    Candidate candidate;
+    while (toValidate.pop(candidate))
+    {
+      if (done)
+      {
+        continue; // drain the queue
+      }
+
+      Clock::time_point begin = Clock::now();
+      LevelSolver solver(candidate.map, rows, cols);
+      bool valid = solver.hasExit() && solver.countTiles(HOLE) > 0 &&
+                   solver.countTiles(ROCK) > 0 && solver.countTiles(PICK) > 0 &&
+                   solver.interactiveTiles() <= LevelSolver::MAX_TILES &&
+                   !solver.solvableWithoutItems(settings.maxSteps);
+      validateStage.processed++;
+      addBusyTime(validateStage, begin);
+
+      if (valid)
+      {
+        validateStage.passed++;
+        toSolve.push(candidate);
+      }
+      else
+      {
+        resolve(candidate.seed);
+      }
+    }
+    toSolve.close();
+  }));
+
+  // Solve: keep maps whose optimal solution uses every mechanic and falls in
+  // the requested step range
+  for (int i = 0; i < solveStage.workers; i++)
+  {
+    threads.push_back(std::thread([&]()
+    {
+      Trace::nameThread("solve");
+      Candidate candidate;
+      while (toSolve.pop(candidate))
+      {
+        if (done)
+        {
+          continue;
+        }
+
+        Clock::time_point begin = Clock::now();
+        LevelSolver solver(candidate.map, rows, cols);
+        candidate.result = solver.solve(settings.maxSteps, MAX_SEARCH_STATES);
+        const LevelSolver::Result& result = candidate.result;
+        bool keep = result.solved && result.steps >= settings.minSteps &&
+                    result.picksTaken > 0 && result.rocksMined > 0 &&
+                    result.holesFilled > 0;
+        solveStage.processed++;
+        addBusyTime(solveStage, begin);
+
+        if (keep)
+        {
+          solveStage.passed++;
+          toScore.push(candidate);
+        }
+        else
+        {
+          resolve(candidate.seed);
+        }
+      }
+
+      if (--solversLeft == 0)
+      {
+        toScore.close();
+      }
+    }));
+  }
+
+  // Score: rate each accepted level's difficulty
+  threads.push_back(std::thread([&]()
+  {
+    Trace::nameThread("score");
+    Candidate candidate;
+    while (toScore.pop(candidate))
+    {
+      Clock::time_point begin = Clock::now();
+      LevelSolver solver(candidate.map, rows, cols);
+      candidate.difficulty = solver.difficulty(candidate.result);
+      scoreStage.processed++;
+      scoreStage.passed++;
+      addBusyTime(scoreStage, begin);
+
+      accepted.push(candidate);
+    }
+    accepted.close();
+  }));
+
+  // Collect accepted levels in seed order, adding each once every lower seed
+  // has been resolved, until the pack is full; then stop the pipeline
+  std::vector<Candidate> levels;
+  std::map<unsigned long long, Candidate> waiting;
+  auto addResolved = [&]()
+  {
+    std::lock_guard<std::mutex> guard(resolvedLock);
+    while (static_cast<int>(levels.size()) < settings.count &&
+           !waiting.empty() && waiting.begin()->first < resolvedBelow)
+    {
+      levels.push_back(waiting.begin()->second);
+      waiting.erase(waiting.begin());
+    }
+  };
+
+  Candidate candidate;
+  while (accepted.pop(candidate))
+  {
+    waiting[candidate.seed] = candidate;
+    resolve(candidate.seed);
+    addResolved();
+
+    if (static_cast<int>(levels.size()) == settings.count && !done)
+    {
+      done = true;
+      toValidate.close();
+    }
+  }
+  addResolved(); // the last rejections may have come after the last level
+
+  for (std::vector<std::thread>::iterator i = threads.begin();
+       i != threads.end(); i++)
+  {
+    i->join();
+  }
+
+  double seconds = std::chrono::duration<double>(Clock::now() - started).count();
+
+  std::vector<LevelPack::Level> pack;
+  for (std::vector<Candidate>::iterator i = levels.begin();
+       i != levels.end(); i++)
+  {
+    LevelPack::Level level;
+    level.rows = rows;
+    level.cols = cols;
+    level.steps = i->result.steps;
+    level.difficulty = i->difficulty;
+    level.seed = i->seed;
+    level.map = i->map;
+    pack.push_back(level);
+  }
+
+  if (!LevelPack::save(settings.filename, pack))
+  {
+    Trace::stop();
+    std::cout << "Could not write " << settings.filename << "\n";
+    return 1;
+  }
+
+  std::cout << "Wrote " << pack.size() << " levels to " << settings.filename
+            << " in " << std::fixed << std::setprecision(2) << seconds
+            << " s (" << std::setprecision(1)
+            << (seconds > 0 ? pack.size() / seconds : 0) << " levels/sec)\n";
+  printReport(stages, 4, seconds);
+
+  Trace::stop();
+  return 0;
+}
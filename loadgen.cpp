@@ -0,0 +1,296 @@
+/*********************************************************************
+** Program name: loadgen.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Load generator for the game server. Opens many connections at
+** once, each playing random keys, one at a time, for a number of turns, and
+** reports how many sessions were served, the turns per second and the time
+** from sending a key to receiving the whole reply at several percentiles.
+** Runs on one epoll event loop, like each of the server's threads. With
+** -game shared, every connection joins the server's shared cave instead of
+** playing a game of its own.
+**
+** Usage: loadgen [-port n | -unix path] [-connections n] [-turns n]
+**                [-seed n] [-game own|shared]
+*********************************************************************/
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  typedef std::chrono::steady_clock Clock;
+
+  const char KEYS[] = "wasdwasde1u"; // mostly moves; 1 plays and accepts
+  const char JOIN_KEY = '3'; // joins the shared cave from the main menu
+  const int MAX_EVENTS = 256;
+
+  // One simulated player
+  struct Client
+  {
+    int fd;
+    int turnsLeft;
+    Clock::time_point sentAt;
+    std::string tail; // last bytes received, to spot the prompt
+  };
+
+  // Connects to the server, blocking until it is accepted into the backlog;
+  // returns -1 on failure
+  int connectTo(int port, const std::string& unixPath)
+  {
+    int fd;
+    int result;
+    if (unixPath.empty())
+    {
+      sockaddr_in address;
+      std::memset(&address, 0, sizeof(address));
+      address.sin_family = AF_INET;
+      address.sin_port = htons(port);
+      address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      fd = socket(AF_INET, SOCK_STREAM, 0);
+      result = connect(fd, reinterpret_cast<sockaddr*>(&address),
+                       sizeof(address));
+      int on = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+    else
+    {
+      sockaddr_un address;
+      std::memset(&address, 0, sizeof(address));
+      address.sun_family = AF_UNIX;
+      unixPath.copy(address.sun_path, sizeof(address.sun_path) - 1);
+      fd = socket(AF_UNIX, SOCK_STREAM, 0);
+      result = connect(fd, reinterpret_cast<sockaddr*>(&address),
+                       sizeof(address));
+    }
+
+    if (fd >= 0 && result != 0)
+    {
+      close(fd);
+      return -1;
+    }
+    if (fd >= 0)
+    {
+      fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    }
+    return fd;
+  }
+
+  // Returns the latency at fraction of the way through sorted latencies
+  long percentile(const std::vector<long>& sorted, double fraction)
+  {
+    if (sorted.empty())
+    {
+      return 0;
+    }
+    std::size_t index = static_cast<std::size_t>(fraction * (sorted.size() - 1));
+    return sorted[index];
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  std::string unixPath;
+  int port = 7777;
+  int connections = 1000;
+  int turns = 100;
+  unsigned long long random = 1;
+  bool shared = false;
+
+  bool valid = argc % 2 == 1;
+  for (int i = 1; valid && i + 1 < argc; i += 2)
+  {
+    std::string flag = argv[i];
+    std::string value = argv[i + 1];
+
+    if (flag == "-port")
+    {
+      port = std::atoi(value.c_str());
+    }
+    else if (flag == "-unix")
+    {
+      unixPath = value;
+    }
+    else if (flag == "-connections")
+    {
+      connections = std::atoi(value.c_str());
+    }
+    else if (flag == "-turns")
+    {
+      turns = std::atoi(value.c_str());
+    }
+    else if (flag == "-seed")
+    {
+      random = std::strtoull(value.c_str(), nullptr, 10);
+    }
+    else if (flag == "-game" && (value == "own" || value == "shared"))
+    {
+      shared = value == "shared";
+    }
+    else
+    {
+      valid = false;
+    }
+  }
+
+  if (!valid || connections < 1 || turns < 1)
+  {
+    std::cout << "Usage: loadgen [-port n | -unix path] [-connections n] "
+              << "[-turns n] [-seed n] [-game own|shared]\n";
+    return 1;
+  }
+
+  rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+  {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+
+  int epollFd = epoll_create1(0);
+  std::vector<Client> clients(connections);
+  Clock::time_point started = Clock::now();
+  for (int i = 0; i < connections; i++)
+  {
+    Client& client = clients[i];
+    client.fd = connectTo(port, unixPath);
+    if (client.fd < 0)
+    {
+      std::cout << "Could not open connection " << i + 1 << ": "
+                << std::strerror(errno) << "\n";
+      return 1;
+    }
+    client.turnsLeft = turns;
+
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u32 = i;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, client.fd, &event);
+  }
+  double connectSeconds =
+    std::chrono::duration<double>(Clock::now() - started).count();
+
+  // Each client sends a key once the whole reply to the last one, ending
+  // with the prompt, has arrived
+  std::vector<long> latencies;
+  latencies.reserve(static_cast<std::size_t>(connections) * turns);
+  int open = connections;
+  int served = 0;
+  int dropped = 0;
+  epoll_event events[MAX_EVENTS];
+  char buffer[16384];
+
+  started = Clock::now();
+  while (open > 0)
+  {
+    int count = epoll_wait(epollFd, events, MAX_EVENTS, 5000);
+    if (count <= 0)
+    {
+      std::cout << "Timed out waiting for the server\n";
+      break;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+      Client& client = clients[events[i].data.u32];
+      bool replied = false;
+      bool closed = false;
+      while (true)
+      {
+        ssize_t received = recv(client.fd, buffer, sizeof(buffer), 0);
+        if (received > 0)
+        {
+          client.tail.append(buffer, received);
+          if (client.tail.length() > 2)
+          {
+            client.tail.erase(0, client.tail.length() - 2);
+          }
+          replied = client.tail == "> ";
+        }
+        else
+        {
+          closed = received == 0 ||
+                   (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+          break;
+        }
+      }
+
+      if (closed)
+      {
+        close(client.fd);
+        dropped++;
+        open--;
+        continue;
+      }
+      if (!replied)
+      {
+        continue;
+      }
+
+      Clock::time_point now = Clock::now();
+      if (client.turnsLeft < turns) // the first reply is the greeting
+      {
+        latencies.push_back(std::chrono::duration_cast<
+          std::chrono::microseconds>(now - client.sentAt).count());
+      }
+      if (client.turnsLeft == 0)
+      {
+        close(client.fd);
+        served++;
+        open--;
+        continue;
+      }
+
+      random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+      char line[2] = { KEYS[(random >> 33) % (sizeof(KEYS) - 1)], '\n' };
+      if (shared && client.turnsLeft == turns)
+      {
+        line[0] = JOIN_KEY;
+      }
+      client.sentAt = now;
+      client.turnsLeft--;
+      client.tail.clear();
+      if (send(client.fd, line, sizeof(line), MSG_NOSIGNAL) != sizeof(line))
+      {
+        close(client.fd);
+        dropped++;
+        open--;
+      }
+    }
+  }
+
+  double seconds = std::chrono::duration<double>(Clock::now() - started).count();
+  std::sort(latencies.begin(), latencies.end());
+
+  std::cout << std::fixed << std::setprecision(2)
+            << "Connections:   " << connections << " opened in "
+            << connectSeconds << " s\n"
+            << "Sessions:      " << served << " served, " << dropped
+            << " dropped\n"
+            << "Turns:         " << latencies.size() << " in " << seconds
+            << " s, " << std::setprecision(0)
+            << (seconds > 0 ? latencies.size() / seconds : 0) << "/sec\n"
+            << "Turn latency:  p50 " << percentile(latencies, 0.50)
+            << " us, p99 " << percentile(latencies, 0.99) << " us, p99.9 "
+            << percentile(latencies, 0.999) << " us, max "
+            << (latencies.empty() ? 0 : latencies.back()) << " us\n";
+
+  close(epollFd);
+  return dropped == 0 && served == connections ? 0 : 1;
+}
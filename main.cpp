@@ -3,16 +3,135 @@
 ** Author: Jesse McKenna
 ** Date: 11/19/2017
 ** Description: Runs the game contained in game.hpp until the player chooses to
-** quit
+** quit. Started with "-record file", each game is recorded to file as a replay
+** that the playback tool can run again. Wins on the map are ranked in
+** leaderboard.log under the name given with "-name", or the user's login.
+** Started with "-stats file", the game's turns are measured and the latencies
+** and counts are written to file after each game. Started with "-trace file",
+** a timeline of loading, drawing, turns and the computer player's searches is
+** written to file for Perfetto or chrome://tracing. Started with "-memory
+** file", the memory held by spaces, maps, inventories, menus and caches is
+** written to file after each game and on exit.
 *********************************************************************/
 
 #include "game.hpp"
+#include "leaderboard.hpp"
 #include "menu.hpp"
 #include "getInput.hpp"
+#include "memoryStats.hpp"
+#include "turnStats.hpp"
+#include "trace.hpp"
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <string>
 
-int main()
+namespace
 {
+  const char LEADERBOARD_FILENAME[] = "leaderboard.log";
+
+  // Returns the user's login name, or "player" if it is not known
+  std::string loginName()
+  {
+    const char* names[] = { "USER", "USERNAME" };
+    for (int i = 0; i < 2; i++)
+    {
+      const char* name = std::getenv(names[i]);
+      if (name != nullptr && *name != '\0')
+      {
+        return name;
+      }
+    }
+    return "player";
+  }
+
+  // Writes the stats so far to filename, replacing the last game's
+  void writeStats(TurnStats& stats, const std::string& filename)
+  {
+    std::ofstream out(filename.c_str(), std::ios::out | std::ios::trunc);
+    stats.print(out);
+    if (!out)
+    {
+      std::cout << "Could not write " << filename << "\n";
+    }
+  }
+
+  // Writes the memory report to filename, replacing the last one; does
+  // nothing if filename is empty
+  void writeMemory(const std::string& filename)
+  {
+    if (filename.empty())
+    {
+      return;
+    }
+    std::ofstream out(filename.c_str(), std::ios::out | std::ios::trunc);
+    MemoryStats::print(out);
+    if (!out)
+    {
+      std::cout << "Could not write " << filename << "\n";
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  std::string replayFilename;
+  std::string statsFilename;
+  std::string traceFilename;
+  std::string memoryFilename;
+  std::string playerName = loginName();
+  bool valid = argc % 2 == 1;
+  for (int i = 1; valid && i + 1 < argc; i += 2)
+  {
+    std::string flag = argv[i];
+    if (flag == "-record")
+    {
+      replayFilename = argv[i + 1];
+    }
+    else if (flag == "-name" && *argv[i + 1] != '\0')
+    {
+      playerName = argv[i + 1];
+    }
+    else if (flag == "-stats")
+    {
+      statsFilename = argv[i + 1];
+    }
+    else if (flag == "-trace")
+    {
+      traceFilename = argv[i + 1];
+    }
+    else if (flag == "-memory")
+    {
+      memoryFilename = argv[i + 1];
+    }
+    else
+    {
+      valid = false;
+    }
+  }
+  if (!valid)
+  {
+    std::cout << "Usage: main [-record file] [-name name] [-stats file] "
+              << "[-trace file] [-memory file]\n";
+    return 1;
+  }
+  if (!traceFilename.empty() && !Trace::start(traceFilename))
+  {
+    std::cout << "Could not write " << traceFilename << "\n";
+    return 1;
+  }
+  Trace::nameThread("main");
+
+  // Measured from here, so that every byte written to the terminal is counted
+  std::unique_ptr<TurnStats> stats;
+  if (!statsFilename.empty())
+  {
+    stats.reset(new TurnStats);
+    stats->countBytes(std::cout);
+  }
+
   // Introduction
   std::cout
     << "    mm         mm         mm\n"
@@ -23,12 +142,17 @@ int main()
     << "\n--- Welcome to Cave Escape! ---\n";
 
   // Main menu
-  Menu mainMenu(2);
+  Menu mainMenu(5);
   mainMenu.setPrompt(1, "Play");
-  mainMenu.setPrompt(2, "Exit");
+  mainMenu.setPrompt(2, "Play endless cave");
+  mainMenu.setPrompt(3, "Watch the computer play");
+  mainMenu.setPrompt(4, "Continue saved game");
+  mainMenu.setPrompt(5, "Exit");
   int mainChoice = mainMenu.showMenu();
-  if (mainChoice == 2)
+  if (mainChoice == 5)
   {
+    writeMemory(memoryFilename);
+    Trace::stop();
     return 0;
   }
 
@@ -39,15 +163,47 @@ int main()
   int replayChoice;
 
   Game game;
+  game.setRecording(replayFilename);
+  game.setStats(stats.get());
+
+  Leaderboard leaderboard;
+  if (leaderboard.open(LEADERBOARD_FILENAME))
+  {
+    game.setLeaderboard(&leaderboard, playerName);
+  }
+  else
+  {
+    std::cout << "Could not open " << LEADERBOARD_FILENAME
+              << "; wins will not be ranked.\n\n";
+  }
+  if (mainChoice == 2)
+  {
+    game.setEndless(true, std::time(nullptr)); // new cave every run
+  }
+  else if (mainChoice == 3)
+  {
+    game.setAutoplay(true);
+  }
+  else if (mainChoice == 4 && !game.continueSavedGame())
+  {
+    std::cout << "There is no saved game; starting a new one.\n\n";
+  }
 
   // Game loop
   do
   {
     game.play();
+    if (stats)
+    {
+      writeStats(*stats, statsFilename);
+    }
+    writeMemory(memoryFilename);
 
     // Ask if player wants to play again
     replayChoice = replayMenu.showMenu();
   } while (replayChoice == 1); // repeat game until player chooses to quit
 
+  writeMemory(memoryFilename);
+  Trace::stop();
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,392 @@
+/*********************************************************************
+** Program name: mctsAgent.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Computer player that chooses actions with Monte Carlo tree
+** search. Each search thread keeps its own copy of the game and its own tree
+** (root parallelism); their visit counts are added together to choose an
+** action. The part of each tree below the chosen action is kept for the next
+** turn.
+*********************************************************************/
+
+#include "mctsAgent.hpp"
+#include "board.hpp"
+#include "gameState.hpp"
+#include "player.hpp"
+#include "space.hpp"
+#include "symbols.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  const double EXPLORATION = 0.7; // UCT exploration constant
+  const double PROGRESS_REWARD = 0.5; // most a game that is not won can earn
+  const double ROCK_REWARD = 0.25; // worth of a rock against reaching the exit
+  const int MAX_PLAYOUT_ACTIONS = 200;
+  const int CLOCK_CHECK_INTERVAL = 64; // iterations between deadline checks
+
+  const GameState::Action MOVES[] = { GameState::MOVE_UP, GameState::MOVE_DOWN,
+                                      GameState::MOVE_LEFT,
+                                      GameState::MOVE_RIGHT };
+  const Space::Direction DIRECTIONS[] = { Space::UP, Space::DOWN, Space::LEFT,
+                                          Space::RIGHT };
+}
+
+// --- Constructor ---
+// Builds a copy of the map for every search thread, and measures how far each
+// space is from the exit for scoring games that are not won
+MctsAgent::MctsAgent(const std::string& map, int rows, int cols,
+                     Settings settings)
+{
+  this->settings = settings;
+  if (this->settings.threads < 1)
+  {
+    this->settings.threads = 1;
+  }
+  lastIterations = 0;
+  lastSeconds = 0;
+
+  // Moves from every space to the nearest exit, ignoring holes
+  std::vector<int> distance(map.length(), -1);
+  std::deque<int> open;
+  for (int i = 0, n = map.length(); i < n; i++)
+  {
+    if (map[i] == EXIT)
+    {
+      distance[i] = 0;
+      open.push_back(i);
+    }
+  }
+
+  maxDistance = 1;
+  while (!open.empty())
+  {
+    int cell = open.front();
+    open.pop_front();
+    int row = cell / cols;
+    int col = cell % cols;
+    int neighbours[] = { row > 0 ? cell - cols : -1,
+                         row < rows - 1 ? cell + cols : -1,
+                         col > 0 ? cell - 1 : -1,
+                         col < cols - 1 ? cell + 1 : -1 };
+
+    for (int d = 0; d < 4; d++)
+    {
+      int next = neighbours[d];
+      if (next >= 0 && distance[next] < 0 && map[next] != WALL)
+      {
+        distance[next] = distance[cell] + 1;
+        maxDistance = std::max(maxDistance, distance[next]);
+        open.push_back(next);
+      }
+    }
+  }
+
+  for (int t = 0; t < this->settings.threads; t++)
+  {
+    std::unique_ptr<Worker> worker(new Worker);
+    worker->state.reset(new GameState(new Board(map, rows, cols), false));
+    worker->random = settings.seed * 0x9E3779B97F4A7C15ULL + t + 1;
+    worker->iterations = 0;
+
+    Board* board = worker->state->getBoard();
+    for (int i = 0; i < rows; i++)
+    {
+      for (int j = 0; j < cols; j++)
+      {
+        int cells = distance[i * cols + j];
+        worker->distance[board->getSpace(i, j)] =
+          cells >= 0 ? cells : maxDistance;
+      }
+    }
+
+    worker->root.reset(newNode(*worker, nullptr, GameState::INSPECT));
+    workers.push_back(std::move(worker));
+  }
+}
+
+// --- legalActions ---
+// Fills actions with the actions worth considering in state: accepting an
+// offer, inspecting a space that will make one, and moves that neither hit a
+// wall nor drop the player into a hole they cannot fill
+void MctsAgent::legalActions(GameState& state,
+                             std::vector<GameState::Action>& actions)
+{
+  actions.clear();
+  Player* player = state.getPlayer();
+  if (player->getState() != Player::PLAYING)
+  {
+    return;
+  }
+
+  if (state.getOffer() != Space::NO_OFFER)
+  {
+    actions.push_back(GameState::ACCEPT);
+    return;
+  }
+
+  Space* space = state.getBoard()->getPlayerSpace();
+  char symbol = space->getDefaultSymbol();
+  if (!player->inventoryFull() &&
+      (symbol == PICK || (symbol == ROCK && player->hasItem(PICK))))
+  {
+    actions.push_back(GameState::INSPECT);
+  }
+
+  for (int d = 0; d < 4; d++)
+  {
+    Space* target = space->getAdjacent(DIRECTIONS[d]);
+    if (target != nullptr && target->isWalkable() &&
+        (target->getDefaultSymbol() != HOLE || player->hasItem(ROCK)))
+    {
+      actions.push_back(MOVES[d]);
+    }
+  }
+}
+
+// --- nextRandom ---
+// xorshift64*
+unsigned long long MctsAgent::nextRandom(Worker& worker)
+{
+  worker.random ^= worker.random >> 12;
+  worker.random ^= worker.random << 25;
+  worker.random ^= worker.random >> 27;
+  return (worker.random * 0x2545F4914F6CDD1DULL) >> 32;
+}
+
+// --- newNode ---
+// Creates a tree node for the worker's current game state
+MctsAgent::Node* MctsAgent::newNode(Worker& worker, Node* parent,
+                                    GameState::Action action)
+{
+  Node* node = new Node;
+  node->action = action;
+  node->parent = parent;
+  node->visits = 0;
+  node->reward = 0;
+  legalActions(*worker.state, node->untried);
+  return node;
+}
+
+// --- select ---
+// Returns the child of node with the best upper confidence bound (UCT)
+MctsAgent::Node* MctsAgent::select(Node* node)
+{
+  Node* best = nullptr;
+  double bestScore = -1;
+  double logVisits = std::log(static_cast<double>(node->visits));
+
+  for (int i = 0, n = node->children.size(); i < n; i++)
+  {
+    Node* child = node->children[i].get();
+    double score = child->reward / child->visits +
+                   EXPLORATION * std::sqrt(logVisits / child->visits);
+    if (score > bestScore)
+    {
+      best = child;
+      bestScore = score;
+    }
+  }
+  return best;
+}
+
+// --- playout ---
+// Plays random legal actions until the game ends and returns its reward: 1 for
+// a win, 0 for falling in a hole, otherwise up to PROGRESS_REWARD for ending
+// close to the exit with rocks in hand
+double MctsAgent::playout(Worker& worker, std::vector<GameState::Action>& actions)
+{
+  GameState& state = *worker.state;
+
+  for (int i = 0; i < MAX_PLAYOUT_ACTIONS; i++)
+  {
+    legalActions(state, actions);
+    if (actions.empty())
+    {
+      break;
+    }
+    state.step(actions[nextRandom(worker) % actions.size()]);
+  }
+
+  if (state.getPlayer()->getState() == Player::WIN)
+  {
+    return 1.0;
+  }
+  if (state.getPlayer()->getState() == Player::LOSE && state.getSteps() >= 0)
+  {
+    return 0; // fell in a hole
+  }
+
+  // Rocks are what get the player past holes, so holding them counts too
+  Player* player = state.getPlayer();
+  int rocks = 0;
+  for (int i = 0, n = player->getInventory().size(); i < n; i++)
+  {
+    rocks += player->getInventory()[i] == ROCK ? 1 : 0;
+  }
+  int distance = worker.distance[state.getBoard()->getPlayerSpace()];
+  double closeness = 1.0 - static_cast<double>(distance) / maxDistance;
+  return PROGRESS_REWARD * (closeness + ROCK_REWARD * rocks) /
+         (1.0 + ROCK_REWARD * Player::INVENTORY_MAX);
+}
+
+// --- search ---
+// Runs one thread's share of the search from the current turn
+void MctsAgent::search(Worker& worker)
+{
+  Trace::Scope scope("search", "solver");
+  GameState& state = *worker.state;
+  GameState::Mark start = state.getMark();
+  std::vector<GameState::Action> actions;
+
+  std::chrono::steady_clock::time_point deadline =
+    std::chrono::steady_clock::now() +
+    std::chrono::milliseconds(settings.milliseconds);
+
+  worker.iterations = 0;
+  for (long i = 0; ; i++)
+  {
+    if (settings.iterations > 0 && i >= settings.iterations)
+    {
+      break;
+    }
+    if (settings.iterations <= 0 && i % CLOCK_CHECK_INTERVAL == 0 &&
+        std::chrono::steady_clock::now() >= deadline)
+    {
+      break;
+    }
+
+    // Selection: follow the best children down to a node with untried actions
+    Node* node = worker.root.get();
+    while (node->untried.empty() && !node->children.empty())
+    {
+      node = select(node);
+      state.step(node->action);
+    }
+
+    // Expansion: try one new action
+    if (!node->untried.empty())
+    {
+      int pick = nextRandom(worker) % node->untried.size();
+      GameState::Action action = node->untried[pick];
+      node->untried[pick] = node->untried.back();
+      node->untried.pop_back();
+
+      state.step(action);
+      Node* child = newNode(worker, node, action);
+      node->children.push_back(std::unique_ptr<Node>(child));
+      node = child;
+    }
+
+    // Simulation and backpropagation
+    double reward = playout(worker, actions);
+    for (; node != nullptr; node = node->parent)
+    {
+      node->visits++;
+      node->reward += reward;
+    }
+
+    state.rollback(start);
+    worker.iterations++;
+  }
+}
+
+// --- chooseAction ---
+// Searches from the current turn on every thread and returns the action tried
+// most often across all of them
+GameState::Action MctsAgent::chooseAction()
+{
+  Trace::Scope scope("choose action", "solver");
+  std::chrono::steady_clock::time_point started =
+    std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for (int t = 1; t < settings.threads; t++)
+  {
+    threads.push_back(std::thread(&MctsAgent::search, this,
+                                  std::ref(*workers[t])));
+  }
+  search(*workers[0]); // the calling thread does a share of the work
+  for (int t = 0, n = threads.size(); t < n; t++)
+  {
+    threads[t].join();
+  }
+
+  lastSeconds = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - started).count();
+
+  // Add up visits to each action over every thread's tree
+  long visits[GameState::DECLINE + 1] = { 0 };
+  lastIterations = 0;
+  for (int t = 0; t < settings.threads; t++)
+  {
+    Node* root = workers[t]->root.get();
+    for (int i = 0, n = root->children.size(); i < n; i++)
+    {
+      visits[root->children[i]->action] += root->children[i]->visits;
+    }
+    lastIterations += workers[t]->iterations;
+  }
+
+  GameState::Action best = GameState::QUIT; // if there is nothing left to try
+  long bestVisits = 0;
+  for (int a = 0; a <= GameState::DECLINE; a++)
+  {
+    if (visits[a] > bestVisits)
+    {
+      best = static_cast<GameState::Action>(a);
+      bestVisits = visits[a];
+    }
+  }
+  return best;
+}
+
+// --- advance ---
+// Follows an action taken in the real game, keeping the subtree below it as
+// the root of the next search
+void MctsAgent::advance(GameState::Action action)
+{
+  for (int t = 0; t < settings.threads; t++)
+  {
+    Worker& worker = *workers[t];
+    worker.state->step(action);
+
+    std::unique_ptr<Node> next;
+    Node* root = worker.root.get();
+    for (int i = 0, n = root->children.size(); i < n; i++)
+    {
+      if (root->children[i]->action == action)
+      {
+        next = std::move(root->children[i]);
+        break;
+      }
+    }
+
+    if (next == nullptr)
+    {
+      next.reset(newNode(worker, nullptr, action));
+    }
+    next->parent = nullptr;
+    worker.root = std::move(next); // frees the rest of the old tree
+  }
+}
+
+// --- getIterations ---
+// Return the number of playouts in the last search, over all threads
+long MctsAgent::getIterations()
+{
+  return lastIterations;
+}
+
+// --- getIterationsPerSecond ---
+double MctsAgent::getIterationsPerSecond()
+{
+  return lastSeconds > 0 ? lastIterations / lastSeconds : 0;
+}
@@ -0,0 +1,79 @@
+/*********************************************************************
+** Program name: mctsAgent.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Computer player that chooses actions with Monte Carlo tree
+** search. Each search thread keeps its own copy of the game and its own tree
+** (root parallelism); their visit counts are added together to choose an
+** action. The part of each tree below the chosen action is kept for the next
+** turn.
+*********************************************************************/
+
+#ifndef MCTSAGENT_HPP
+#define MCTSAGENT_HPP
+
+#include "gameState.hpp"
+#include "space.hpp"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class MctsAgent
+{
+public:
+  struct Settings
+  {
+    int iterations; // per thread per turn; 0 to use milliseconds instead
+    int milliseconds; // time per turn when iterations is 0
+    int threads;
+    unsigned long long seed;
+  };
+
+private:
+  struct Node
+  {
+    GameState::Action action; // action leading to this node
+    Node* parent;
+    long visits;
+    double reward; // total reward of every playout through this node
+    std::vector<GameState::Action> untried;
+    std::vector<std::unique_ptr<Node> > children;
+  };
+
+  // One search thread's game, tree and random numbers
+  struct Worker
+  {
+    std::unique_ptr<GameState> state;
+    std::unique_ptr<Node> root;
+    std::unordered_map<Space*, int> distance; // moves from each space to exit
+    unsigned long long random;
+    long iterations; // playouts during the last search
+  };
+
+  Settings settings;
+  std::vector<std::unique_ptr<Worker> > workers;
+  int maxDistance;
+  long lastIterations;
+  double lastSeconds;
+
+  static void legalActions(GameState& state,
+                           std::vector<GameState::Action>& actions);
+  static unsigned long long nextRandom(Worker& worker);
+
+  Node* newNode(Worker& worker, Node* parent, GameState::Action action);
+  Node* select(Node* node);
+  double playout(Worker& worker, std::vector<GameState::Action>& actions);
+  void search(Worker& worker);
+
+public:
+  MctsAgent(const std::string& map, int rows, int cols, Settings settings);
+
+  GameState::Action chooseAction();
+  void advance(GameState::Action action);
+
+  long getIterations();
+  double getIterationsPerSecond();
+};
+
+#endif
@@ -0,0 +1,189 @@
+/*********************************************************************
+** Program name: memoryStats.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Counts the memory held by the game's structures, by kind: the
+** spaces of each type, the map strings boards are built from, the players'
+** inventories, the menus and the endless cave's chunk caches. Spaces count
+** themselves through their own operator new and delete, inventories through
+** a counting allocator, and the rest where they are allocated and freed. The
+** report shows the bytes held now and at most, next to the process's peak
+** resident set size.
+*********************************************************************/
+
+#include "memoryStats.hpp"
+#include "space.hpp"
+#include <atomic>
+#include <cstddef>
+#include <iomanip>
+#include <new>
+#include <ostream>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+  const char* CATEGORY_NAMES[] = { "wall spaces", "empty spaces",
+                                   "hole spaces", "exit spaces", "maps",
+                                   "inventories", "menus", "caches" };
+  const int ADJACENT = 4; // pointers from each space to its neighbors
+
+  // Zeroed before any constructor runs, so counting works from the start
+  std::atomic<long long> bytes[MemoryStats::CATEGORY_COUNT];
+  std::atomic<long long> peakBytes[MemoryStats::CATEGORY_COUNT];
+  std::atomic<long long> blocks[MemoryStats::CATEGORY_COUNT];
+  std::atomic<long long> peakBlocks[MemoryStats::CATEGORY_COUNT];
+
+  // Raises peak to now if now is higher
+  void raise(std::atomic<long long>& peak, long long now)
+  {
+    long long seen = peak.load(std::memory_order_relaxed);
+    while (now > seen &&
+           !peak.compare_exchange_weak(seen, now, std::memory_order_relaxed))
+    {
+    }
+  }
+}
+
+// --- allocate ---
+// Allocates bytes and counts them under category
+void* MemoryStats::allocate(Category category, std::size_t bytes)
+{
+  void* pointer = ::operator new(bytes);
+  add(category, bytes);
+  return pointer;
+}
+
+// --- release ---
+// Frees pointer, allocated by allocate with the same category and bytes
+void MemoryStats::release(Category category, void* pointer, std::size_t bytes)
+{
+  remove(category, bytes);
+  ::operator delete(pointer);
+}
+
+// --- add ---
+// Counts a block of count bytes allocated for category
+void MemoryStats::add(Category category, long long count)
+{
+  raise(peakBlocks[category],
+        blocks[category].fetch_add(1, std::memory_order_relaxed) + 1);
+  raise(peakBytes[category],
+        bytes[category].fetch_add(count, std::memory_order_relaxed) + count);
+}
+
+// --- remove ---
+// Counts a block of count bytes for category as freed
+void MemoryStats::remove(Category category, long long count)
+{
+  blocks[category].fetch_sub(1, std::memory_order_relaxed);
+  bytes[category].fetch_sub(count, std::memory_order_relaxed);
+}
+
+// --- stringBytes ---
+// Returns the bytes a string holds: the string itself, plus its characters
+// if they are too long to be kept inside it
+long long MemoryStats::stringBytes(const std::string& text)
+{
+  const char* object = reinterpret_cast<const char*>(&text);
+  const char* data = text.data();
+  bool inside = data >= object && data < object + sizeof(std::string);
+  return sizeof(std::string) + (inside ? 0 : text.capacity() + 1);
+}
+
+// --- getBytes ---
+long long MemoryStats::getBytes(Category category)
+{
+  return bytes[category].load(std::memory_order_relaxed);
+}
+
+// --- getPeakBytes ---
+long long MemoryStats::getPeakBytes(Category category)
+{
+  return peakBytes[category].load(std::memory_order_relaxed);
+}
+
+// --- getBlocks ---
+// Returns the number of allocations counted under category
+long long MemoryStats::getBlocks(Category category)
+{
+  return blocks[category].load(std::memory_order_relaxed);
+}
+
+// --- getPeakBlocks ---
+// Returns the most allocations counted under category at once
+long long MemoryStats::getPeakBlocks(Category category)
+{
+  return peakBlocks[category].load(std::memory_order_relaxed);
+}
+
+// --- getPeakRss ---
+// Returns the most memory the process has had resident at once, in bytes, or
+// 0 if it is not known
+long long MemoryStats::getPeakRss()
+{
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+  {
+    return counters.PeakWorkingSetSize;
+  }
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return 0;
+  }
+#ifdef __APPLE__
+  return usage.ru_maxrss; // already in bytes
+#else
+  return usage.ru_maxrss * 1024LL;
+#endif
+#endif
+}
+
+// --- print ---
+// Prints the objects and bytes held in each category now, the most bytes each
+// has held, and the process's peak resident set size. The pointers linking
+// spaces to their neighbors are included in the spaces' bytes; they are also
+// shown on their own line.
+void MemoryStats::print(std::ostream& out)
+{
+  out << std::left << std::setw(16) << "memory" << std::right << std::setw(12)
+      << "allocations" << std::setw(16) << "bytes" << std::setw(16)
+      << "peak bytes" << "\n";
+
+  long long totalBytes = 0;
+  long long spaces = 0;
+  long long peakSpaces = 0;
+  for (int i = 0; i < CATEGORY_COUNT; i++)
+  {
+    Category category = static_cast<Category>(i);
+    out << std::left << std::setw(16) << CATEGORY_NAMES[i] << std::right
+        << std::setw(12) << getBlocks(category) << std::setw(16)
+        << getBytes(category) << std::setw(16) << getPeakBytes(category)
+        << "\n";
+    totalBytes += getBytes(category);
+    if (category <= EXIT_SPACES)
+    {
+      spaces += getBlocks(category);
+      peakSpaces += getPeakBlocks(category);
+    }
+  }
+
+  out << std::left << std::setw(28) << "total" << std::right << std::setw(16)
+      << totalBytes << "\n"
+      << std::left << std::setw(28) << "  adjacency pointers" << std::right
+      << std::setw(16) << spaces * ADJACENT * sizeof(Space*) << std::setw(16)
+      << peakSpaces * ADJACENT * sizeof(Space*) << "\n"
+      << std::left << std::setw(28) << "peak resident set" << std::right
+      << std::setw(16) << getPeakRss() << "\n";
+}
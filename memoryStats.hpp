@@ -0,0 +1,95 @@
+/*********************************************************************
+** Program name: memoryStats.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Counts the memory held by the game's structures, by kind: the
+** spaces of each type, the map strings boards are built from, the players'
+** inventories, the menus and the endless cave's chunk caches. Spaces count
+** themselves through their own operator new and delete, inventories through
+** a counting allocator, and the rest where they are allocated and freed. The
+** report shows the bytes held now and at most, next to the process's peak
+** resident set size.
+*********************************************************************/
+
+#ifndef MEMORYSTATS_HPP
+#define MEMORYSTATS_HPP
+
+#include <cstddef>
+#include <iosfwd>
+#include <new>
+#include <string>
+
+class MemoryStats
+{
+public:
+  enum Category
+  {
+    WALL_SPACES,
+    EMPTY_SPACES,
+    HOLE_SPACES,
+    EXIT_SPACES,
+    MAPS, // Board::map strings
+    INVENTORIES, // Player inventories
+    MENUS, // Menu prompts
+    CACHES, // generated and changed chunks of the endless cave
+    CATEGORY_COUNT
+  };
+
+  // Allocator for standard containers that counts what it allocates under
+  // category
+  template <typename T, int category>
+  class Allocator
+  {
+  public:
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind
+    {
+      typedef Allocator<U, category> other;
+    };
+
+    Allocator() {}
+    template <typename U>
+    Allocator(const Allocator<U, category>&) {}
+
+    T* allocate(std::size_t count)
+    {
+      return static_cast<T*>(MemoryStats::allocate(
+        static_cast<Category>(category), count * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, std::size_t count)
+    {
+      MemoryStats::release(static_cast<Category>(category), pointer,
+                           count * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const Allocator<U, category>&) const
+    {
+      return true;
+    }
+
+    template <typename U>
+    bool operator!=(const Allocator<U, category>&) const
+    {
+      return false;
+    }
+  };
+
+  static void* allocate(Category category, std::size_t bytes);
+  static void release(Category category, void* pointer, std::size_t bytes);
+  static void add(Category category, long long bytes);
+  static void remove(Category category, long long bytes);
+  static long long stringBytes(const std::string& text);
+
+  static long long getBytes(Category category);
+  static long long getPeakBytes(Category category);
+  static long long getBlocks(Category category);
+  static long long getPeakBlocks(Category category);
+  static long long getPeakRss();
+  static void print(std::ostream& out);
+};
+
+#endif
@@ -7,6 +7,7 @@
 
 #include "menu.hpp"
 #include "getInput.hpp"
+#include "memoryStats.hpp"
 #include <iostream>
 
 // --- Menu ---
@@ -22,12 +23,34 @@ Menu::Menu(int menuSize)
   }
   
   prompts = new std::string[size];
+  MemoryStats::add(MemoryStats::MENUS, size * sizeof(std::string));
+}
+
+// --- countPrompt ---
+// Counts the characters of prompt in MemoryStats (change 1) or stops counting
+// them (change -1), if they are kept outside the string
+void Menu::countPrompt(const std::string& prompt, int change)
+{
+  long long bytes = MemoryStats::stringBytes(prompt) - sizeof(std::string);
+  if (bytes > 0 && change > 0)
+  {
+    MemoryStats::add(MemoryStats::MENUS, bytes);
+  }
+  else if (bytes > 0)
+  {
+    MemoryStats::remove(MemoryStats::MENUS, bytes);
+  }
 }
 
 // --- ~Menu ---
 // Destructor; deletes the dynamically allocated string array "prompts"
 Menu::~Menu()
 {
+  for (int i = 0; i < size; i++)
+  {
+    countPrompt(prompts[i], -1);
+  }
+  MemoryStats::remove(MemoryStats::MENUS, size * sizeof(std::string));
   delete [] prompts;
   prompts = nullptr;
 }
@@ -42,7 +65,9 @@ void Menu::setPrompt(int number, std::string prompt) // set the desired prompt t
     return; // do nothing if invalid number referenced
   }
 
+  countPrompt(prompts[number - 1], -1);
   prompts[number - 1] = prompt; // put entered prompt into the "prompts" array
+  countPrompt(prompts[number - 1], 1);
 }
 
 // --- showMenu ---
@@ -50,13 +75,7 @@ void Menu::setPrompt(int number, std::string prompt) // set the desired prompt t
 // selection made by the user
 int Menu::showMenu()
 {
-  std::cout << "\n";
-  for (int i = 0; i < size; i++)
-  {
-    std::cout << i + 1 << ". "; // prompt numbering, starting at 1
-    std::cout << prompts[i]; // prompt text
-    std::cout << "\n\n";
-  }
+  print(std::cout);
 
   int choice;
 
@@ -64,3 +83,24 @@ int Menu::showMenu()
 
   return choice;
 }
+
+// --- print ---
+// Prints each prompt in "prompts" to out, e.g. for a player connected to the
+// server, whose choice arrives later
+void Menu::print(std::ostream& out)
+{
+  out << "\n";
+  for (int i = 0; i < size; i++)
+  {
+    out << i + 1 << ". "; // prompt numbering, starting at 1
+    out << prompts[i]; // prompt text
+    out << "\n\n";
+  }
+}
+
+// --- getSize ---
+// Returns the number of prompts, i.e. the highest valid choice
+int Menu::getSize()
+{
+  return size;
+}
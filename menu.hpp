@@ -8,6 +8,7 @@
 #ifndef MENU_HPP
 #define MENU_HPP
 
+#include <iosfwd>
 #include <string>
 
 class Menu
@@ -16,11 +17,15 @@ class Menu
     int size;
     std::string* prompts; // dynamically allocated array of strings
     const int MAX_PROMPTS = 10;
+
+    void countPrompt(const std::string& prompt, int change);
   public:
     Menu(int size); // default constructor takes a menu size
     ~Menu(); // destructor
     void setPrompt(int number, std::string prompt); // set the desired prompt text
     int showMenu(); // displays the menu and returns the selection made
+    void print(std::ostream& out); // displays the menu without waiting
+    int getSize();
 };
 
 #endif
@@ -0,0 +1,151 @@
+/*********************************************************************
+** Program name: messages.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Text shown to the player: the introduction, the controls,
+** what happened on each turn and how the game ended. Written to any stream,
+** so the console game and the game server show the same messages.
+*********************************************************************/
+
+#include "messages.hpp"
+#include "event.hpp"
+#include "gameState.hpp"
+#include "player.hpp"
+#include <ostream>
+#include <vector>
+
+// --- printIntro ---
+// Prints how to play the map, or the endless cave made from seed
+void printIntro(std::ostream& out, bool endless, unsigned long long seed)
+{
+  if (endless)
+  {
+    out << "You (X) are lost in an endless cave (seed " << seed << ").\n"
+        << "Each exit (E) leads deeper and gives you "
+        << GameState::START_STEPS << " more steps,\n"
+        << "but be careful not to fall down any holes (@)!\n\n";
+  }
+  else
+  {
+    out << "You (X) are trapped in a cave.\n"
+        << "Make it to the exit (E) before you run out of steps,\n"
+        << "but be careful not to fall down any holes (@)!\n\n";
+  }
+}
+
+// --- printCaveIntro ---
+// Prints how to play the cave shared by everyone on the game server
+void printCaveIntro(std::ostream& out)
+{
+  out << "You (X) are trapped in a cave with the other players (O).\n"
+      << "Make it to the exit (E) before you run out of steps, but be careful\n"
+      << "not to fall down any holes (@)! Holes filled and items taken are\n"
+      << "gone for everyone.\n\n";
+}
+
+// --- printControls ---
+// Prints the keys for each action; undo is not available in endless caves
+void printControls(std::ostream& out, bool undo)
+{
+  out << "\n"
+      << "Move:   W       Inspect: E       Inventory: I       Quit: Q\n"
+      << "      A S D";
+  if (undo)
+  {
+    out << "     Undo: U          Redo: R";
+  }
+  out << "\n";
+}
+
+// --- printEvents ---
+// Prints a message for each event reported by the game rules
+void printEvents(std::ostream& out, Player* player, const EventList& events)
+{
+  for (EventList::const_iterator i = events.begin(); i != events.end(); i++)
+  {
+    switch (i->type)
+    {
+      case Event::NOTHING_FOUND:
+        out << "\nFound nothing of interest.\n";
+        break;
+      case Event::ROCKS_FOUND:
+        out << "\nA formation of large rocks.\n";
+        break;
+      case Event::PICK_FOUND:
+        out << "\nA pickaxe.\n";
+        break;
+      case Event::HAVE_PICK:
+        out << "You have a pickaxe.\n";
+        break;
+      case Event::HAVE_PICK_FULL:
+        out << "You have a pickaxe, but your inventory is full.\n";
+        break;
+      case Event::HOLE_FILLED:
+        out << "You filled the hole in the ground with rocks to cross it.\n";
+        break;
+      case Event::FELL_IN_HOLE:
+        out << "\nYou fell in a hole!\n";
+        break;
+      case Event::EXIT_REACHED:
+        out << "You reached the exit!\n";
+        break;
+      case Event::PASSAGE_FOUND:
+        out << "You found a passage deeper into the cave!\n";
+        break;
+      case Event::SEGMENT_REACHED:
+        out << "Segment " << i->value << " reached.\n";
+        break;
+      case Event::OUT_OF_STEPS:
+        out << "You ran out of steps!\n";
+        break;
+      case Event::INVENTORY:
+      {
+        const Player::Inventory& inv = player->getInventory();
+        if (inv.size() == 0)
+        {
+          out << "\nInventory is empty.\n";
+        }
+        else
+        {
+          out << "\nInventory: ";
+          for (Player::Inventory::const_iterator j = inv.begin();
+               j != inv.end(); j++)
+          {
+            out << *j << " ";
+          }
+          out << "\n";
+        }
+        break;
+      }
+      case Event::BLOCKED:
+        out << "\nSomeone is in the way.\n";
+        break;
+      case Event::ROCKS_MINED:
+      case Event::PICK_TAKEN:
+      case Event::QUIT:
+        break; // nothing to print
+    }
+  }
+}
+
+// --- printResult ---
+// Prints whether player won or lost, and in an endless cave how far they got
+void printResult(std::ostream& out, Player* player)
+{
+  switch (player->getState())
+  {
+    case Player::WIN:
+      out << "You win!\n";
+      break;
+    case Player::LOSE:
+      out << "Game over.\n";
+      break;
+    default:
+      break;
+  }
+
+  if (player->isEndless())
+  {
+    out << "You passed through " << player->getSegment() << " segments.\n";
+  }
+}
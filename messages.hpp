@@ -0,0 +1,24 @@
+/*********************************************************************
+** Program name: messages.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Text shown to the player: the introduction, the controls,
+** what happened on each turn and how the game ended. Written to any stream,
+** so the console game and the game server show the same messages.
+*********************************************************************/
+
+#ifndef MESSAGES_HPP
+#define MESSAGES_HPP
+
+#include "event.hpp"
+#include <iosfwd>
+
+class Player;
+
+void printIntro(std::ostream& out, bool endless, unsigned long long seed);
+void printCaveIntro(std::ostream& out);
+void printControls(std::ostream& out, bool undo);
+void printEvents(std::ostream& out, Player* player, const EventList& events);
+void printResult(std::ostream& out, Player* player);
+
+#endif
@@ -0,0 +1,293 @@
+/*********************************************************************
+** Program name: playback.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Plays a replay recorded by "main -record file" again and checks
+** that the game ends exactly as it did when it was recorded. Without -rate the
+** replay runs headless at full speed and reports turns per second, so real
+** games can be used to benchmark the rules; with -rate the board is shown
+** after every turn at the given number of turns per second, to watch a game
+** that went wrong. Along the way the game is compared with each keyframe, so
+** a game that goes differently is caught at the first keyframe after.
+**
+** -seek shows the game at any turn, starting from the keyframe before it;
+** -seekbench times that for a number of random turns.
+**
+** Usage: playback file [-map file] [-rate turns/sec] [-repeat n]
+**                      [-seek turn] [-seekbench count]
+*********************************************************************/
+
+#include "replay.hpp"
+#include "board.hpp"
+#include "endlessBoard.hpp"
+#include "gameState.hpp"
+#include "player.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace
+{
+  const char* ACTION_NAMES[] = { "move up", "move down", "move left",
+                                 "move right", "inspect", "inventory", "quit",
+                                 "accept", "decline", "undo", "redo" };
+
+  // Prints how a game ended
+  void printResult(const char* title, const Replay::Result& result)
+  {
+    const char* states[] = { "none", "playing", "win", "lose" };
+    std::cout << title << states[result.state] << ", " << result.steps
+              << " steps left, segment " << result.segment << ", inventory \""
+              << result.inventory << "\"\n";
+  }
+
+  typedef std::chrono::steady_clock Clock;
+
+  // Returns a new game on the replay's map or cave
+  GameState* newGame(Replay& replay, const std::string& map)
+  {
+    Board* board;
+    if (replay.isEndless())
+    {
+      board = new EndlessBoard(replay.getSeed());
+    }
+    else
+    {
+      board = new Board(map, replay.getRows(), replay.getCols());
+    }
+    return new GameState(board, replay.isEndless());
+  }
+
+  // Returns true if state matches keyframe number of replay
+  bool matchesKeyframe(Replay& replay, int number, GameState& state)
+  {
+    std::string expected;
+    std::string actual;
+    state.saveState(actual, false);
+    return replay.getKeyframe(number, expected) && actual == expected;
+  }
+
+  // Plays every action in replay on a new game; shows each turn if rate is
+  // positive. Returns how the game ended, and sets diverged to the first turn
+  // at which the game did not match a keyframe, or -1 if it always did.
+  Replay::Result play(Replay& replay, const std::string& map, double rate,
+                      long& diverged)
+  {
+    // The first keyframe is where the game started, which is not a new game
+    // if it was carried on from a saved game
+    std::unique_ptr<GameState> state(newGame(replay, map));
+    diverged = replay.seek(*state, 0) ? -1 : 0;
+    int keyframe = 1;
+
+    for (long i = 0, n = replay.size(); i < n; i++)
+    {
+      GameState::Action action = replay.getAction(i);
+      state->step(action);
+
+      if (keyframe < replay.getKeyframeCount() &&
+          replay.getKeyframeTurn(keyframe) == i + 1)
+      {
+        if (diverged < 0 && !matchesKeyframe(replay, keyframe, *state))
+        {
+          diverged = i + 1;
+        }
+        keyframe++;
+      }
+
+      if (rate > 0)
+      {
+        std::cout << "\nTurn " << i + 1 << ": " << ACTION_NAMES[action] << ", "
+                  << state->getSteps() << " steps remaining\n";
+        state->getBoard()->print();
+        std::this_thread::sleep_for(std::chrono::microseconds(
+          static_cast<long long>(1e6 / rate)));
+      }
+    }
+
+    return Replay::getResult(*state);
+  }
+
+  // Shows the game at turn; returns false if the replay cannot get there
+  bool showTurn(Replay& replay, const std::string& map, long turn)
+  {
+    std::unique_ptr<GameState> state(newGame(replay, map));
+
+    Clock::time_point started = Clock::now();
+    bool found = replay.seek(*state, turn);
+    double micros = std::chrono::duration<double, std::micro>(
+      Clock::now() - started).count();
+
+    if (!found)
+    {
+      std::cout << "Could not seek to turn " << turn << " of "
+                << replay.size() << "\n";
+      return false;
+    }
+
+    std::cout << "Turn " << turn << " of " << replay.size() << ", "
+              << state->getSteps() << " steps remaining\n";
+    state->getBoard()->print();
+    printResult("State:    ", Replay::getResult(*state));
+    std::cout << std::fixed << std::setprecision(1) << "Seek took " << micros
+              << " us\n";
+    return true;
+  }
+
+  // Seeks to count random turns and prints the average and slowest times
+  bool benchmarkSeek(Replay& replay, const std::string& map, int count)
+  {
+    std::unique_ptr<GameState> state(newGame(replay, map));
+    unsigned long long random = 0x9E3779B97F4A7C15ULL;
+    double total = 0;
+    double slowest = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+      random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+      long turn = (random >> 33) % (replay.size() + 1);
+
+      Clock::time_point started = Clock::now();
+      if (!replay.seek(*state, turn))
+      {
+        std::cout << "Could not seek to turn " << turn << "\n";
+        return false;
+      }
+      double micros = std::chrono::duration<double, std::micro>(
+        Clock::now() - started).count();
+      total += micros;
+      slowest = std::max(slowest, micros);
+    }
+
+    std::cout << std::fixed << std::setprecision(1) << count
+              << " seeks into " << replay.size() << " turns, "
+              << replay.getKeyframeCount() << " keyframes: " << total / count
+              << " us average, " << slowest << " us slowest\n";
+    return true;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  std::string replayFilename;
+  std::string mapFilename = "map.txt";
+  double rate = 0;
+  int repeat = 1;
+  long seekTurn = -1;
+  int seekCount = 0;
+
+  bool valid = argc >= 2 && argc % 2 == 0;
+  if (valid)
+  {
+    replayFilename = argv[1];
+  }
+  for (int i = 2; valid && i + 1 < argc; i += 2)
+  {
+    std::string flag = argv[i];
+    std::string value = argv[i + 1];
+
+    if (flag == "-map")
+    {
+      mapFilename = value;
+    }
+    else if (flag == "-rate")
+    {
+      rate = std::atof(value.c_str());
+    }
+    else if (flag == "-repeat")
+    {
+      repeat = std::atoi(value.c_str());
+    }
+    else if (flag == "-seek")
+    {
+      seekTurn = std::atol(value.c_str());
+      valid = seekTurn >= 0;
+    }
+    else if (flag == "-seekbench")
+    {
+      seekCount = std::atoi(value.c_str());
+      valid = seekCount > 0;
+    }
+    else
+    {
+      valid = false;
+    }
+  }
+
+  if (!valid || rate < 0 || repeat < 1)
+  {
+    std::cout << "Usage: playback file [-map file] [-rate turns/sec] "
+              << "[-repeat n] [-seek turn] [-seekbench count]\n";
+    return 1;
+  }
+
+  Replay replay;
+  if (!replay.load(replayFilename))
+  {
+    std::cout << "Could not read replay " << replayFilename << "\n";
+    return 1;
+  }
+
+  std::string map;
+  if (!replay.isEndless())
+  {
+    int rows;
+    int cols;
+    if (!Board::loadMap(mapFilename, map, rows, cols))
+    {
+      std::cout << "Could not read " << mapFilename << "\n";
+      return 1;
+    }
+    if (Board::hashMap(map) != replay.getMapHash() ||
+        rows != replay.getRows() || cols != replay.getCols())
+    {
+      std::cout << "Replay was not recorded on " << mapFilename << "\n";
+      return 1;
+    }
+  }
+
+  if (seekTurn >= 0)
+  {
+    return showTurn(replay, map, seekTurn) ? 0 : 1;
+  }
+  if (seekCount > 0)
+  {
+    return benchmarkSeek(replay, map, seekCount) ? 0 : 1;
+  }
+
+  Clock::time_point started = Clock::now();
+
+  bool matched = true;
+  long diverged = -1;
+  Replay::Result result;
+  for (int i = 0; i < repeat; i++)
+  {
+    result = play(replay, map, rate, diverged);
+    matched = matched && result == replay.getResult() && diverged < 0;
+  }
+
+  double seconds = std::chrono::duration<double>(Clock::now() - started).count();
+
+  std::cout << "\n";
+  printResult("Recorded: ", replay.getResult());
+  printResult("Played:   ", result);
+  if (diverged >= 0)
+  {
+    std::cout << "Game differs from the recording by turn " << diverged << "\n";
+  }
+  std::cout << (matched ? "Replay verified" : "Replay does not match") << ", "
+            << replay.size() << " turns";
+  if (rate == 0)
+  {
+    std::cout << std::fixed << std::setprecision(0) << ", "
+              << (seconds > 0 ? replay.size() * repeat / seconds : 0)
+              << " turns/sec";
+  }
+  std::cout << "\n";
+
+  return matched ? 0 : 1;
+}
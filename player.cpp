@@ -7,12 +7,13 @@
 *********************************************************************/
 
 #include "player.hpp"
-#include <iostream>
 
 // --- Constructor ---
 Player::Player()
 {
   state = NONE;
+  endless = false;
+  segment = 0;
 }
 
 // --- Destructor ---
@@ -21,6 +22,16 @@ Player::~Player()
   inv.clear();
 }
 
+// --- reset ---
+// Prepares the player for a new game; keeps the inventory's memory so that
+// repeated games do not reallocate it
+void Player::reset()
+{
+  state = NONE;
+  inv.clear();
+  segment = 0;
+}
+
 // --- setState ---
 void Player::setState(Player::State newState)
 {
@@ -47,7 +58,7 @@ void Player::addItem(char item)
 // Search for given item in inventory, and return true if found
 bool Player::hasItem(char item)
 {
-  for (std::vector<char>::iterator i = inv.begin(); i != inv.end(); i++)
+  for (Inventory::iterator i = inv.begin(); i != inv.end(); i++)
   {
     if (*i == item) // if item found
     {
@@ -62,7 +73,7 @@ bool Player::hasItem(char item)
 // if found
 bool Player::useItem(char item)
 {
-  for (std::vector<char>::iterator i = inv.begin(); i != inv.end(); i++)
+  for (Inventory::iterator i = inv.begin(); i != inv.end(); i++)
   {
     if (*i == item) // if item found
     {
@@ -73,23 +84,11 @@ bool Player::useItem(char item)
   return false;
 }
 
-// --- printInventory ---
-// Print each char in inventory
-void Player::printInventory()
+// --- getInventory ---
+// Return the items carried, in the order they were picked up
+const Player::Inventory& Player::getInventory()
 {
-  if (inv.size() == 0)
-  {
-    std::cout << "\nInventory is empty.\n";
-  }
-  else
-  {
-    std::cout << "\nInventory: ";
-    for (std::vector<char>::iterator i = inv.begin(); i != inv.end(); i++)
-    {
-      std::cout << *i << " ";
-    }
-    std::cout << "\n";
-  }
+  return inv;
 }
 
 // --- inventoryFull ---
@@ -97,4 +96,37 @@ void Player::printInventory()
 bool Player::inventoryFull()
 {
   return inv.size() >= INVENTORY_MAX;
+}
+
+// --- setEndless ---
+// Sets whether exits end the game (false) or lead deeper into the cave (true)
+void Player::setEndless(bool status)
+{
+  endless = status;
+  segment = 0;
+}
+
+// --- isEndless ---
+bool Player::isEndless()
+{
+  return endless;
+}
+
+// --- advanceSegment ---
+// Moves the player on to the next segment of an endless cave
+void Player::advanceSegment()
+{
+  segment++;
+}
+
+// --- setSegment ---
+void Player::setSegment(int count)
+{
+  segment = count;
+}
+
+// --- getSegment ---
+int Player::getSegment()
+{
+  return segment;
 }
\ No newline at end of file
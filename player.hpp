@@ -9,6 +9,7 @@
 #ifndef PLAYER_HPP
 #define PLAYER_HPP
 
+#include "memoryStats.hpp"
 #include <vector>
 
 class Player
@@ -16,24 +17,40 @@ class Player
 public:
   enum State { NONE, PLAYING, WIN, LOSE };
 
+  static const int INVENTORY_MAX = 2;
+
+  // Items held, counted in MemoryStats
+  typedef MemoryStats::Allocator<char, MemoryStats::INVENTORIES>
+    InventoryAllocator;
+  typedef std::vector<char, InventoryAllocator> Inventory;
+
 private:
   State state; // player's current state (playing, win, or lose)
 
-  const int INVENTORY_MAX = 2;
-  std::vector<char> inv;
+  Inventory inv;
+
+  bool endless; // true if exits lead to the next segment of an endless cave
+  int segment; // number of exits passed through in endless mode
 
 public:
   Player();
   ~Player();
 
+  void reset(); // empty inventory and segment count for a new game
   void setState(State newState);
   State getState();
 
   void addItem(char item);
   bool hasItem(char item);
   bool useItem(char item);
-  void printInventory();
+  const Inventory& getInventory();
   bool inventoryFull();
+
+  void setEndless(bool status);
+  bool isEndless();
+  void advanceSegment();
+  void setSegment(int count); // e.g. when loading a saved game
+  int getSegment();
 };
 
 #endif
\ No newline at end of file
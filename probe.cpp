@@ -0,0 +1,217 @@
+/*********************************************************************
+** Program name: probe.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Plays a map several times with the tree search computer player
+** at a fixed budget and reports how often it wins, the steps it has left and
+** how many playouts per second it searches. A map the computer rarely wins
+** with a generous budget is hard for people too, so this is used to probe the
+** difficulty of maps, and the playout rate to catch slowdowns in the search.
+**
+** -solve instead finds the shortest win with DfsSolver, which searches the
+** game itself using undo, and checks it against LevelSolver.
+**
+** Usage: probe [-map file] [-n games] [-iterations n | -ms milliseconds]
+**              [-seed n] [-threads n] [-solve max positions]
+*********************************************************************/
+
+#include "mctsAgent.hpp"
+#include "dfsSolver.hpp"
+#include "levelSolver.hpp"
+#include "board.hpp"
+#include "gameState.hpp"
+#include "player.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+  const int MAX_ACTIONS = 200; // per game, in case the computer goes in circles
+
+  // Finds the shortest win with both solvers and prints how they compare;
+  // returns false if they disagree
+  bool solve(const std::string& map, int rows, int cols, long maxNodes)
+  {
+    GameState state(new Board(map, rows, cols), false);
+    DfsSolver solver(state);
+
+    std::chrono::steady_clock::time_point started =
+      std::chrono::steady_clock::now();
+    DfsSolver::Result result = solver.solve(maxNodes);
+    double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - started).count();
+
+    LevelSolver::Result expected =
+      LevelSolver(map, rows, cols).solve(GameState::START_STEPS, maxNodes);
+
+    std::cout << std::fixed << std::setprecision(0);
+    if (result.solved)
+    {
+      std::cout << "Shortest win:  " << result.steps << " steps, "
+                << result.moves << "\n";
+    }
+    else
+    {
+      std::cout << (result.aborted ? "Gave up" : "No win") << " after "
+                << result.nodes << " positions\n";
+    }
+    std::cout << "Search speed:  " << (seconds > 0 ? result.nodes / seconds : 0)
+              << " positions/sec (" << result.nodes << " positions)\n";
+
+    if (result.aborted || expected.aborted)
+    {
+      return true; // nothing to compare
+    }
+    if (result.solved != expected.solved ||
+        (result.solved && result.steps != expected.steps))
+    {
+      std::cout << "LevelSolver disagrees: "
+                << (expected.solved ? "" : "no win, ") << expected.steps
+                << " steps\n";
+      return false;
+    }
+    std::cout << "LevelSolver agrees\n";
+    return true;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  std::string mapFilename = "map.txt";
+  int games = 10;
+  MctsAgent::Settings settings;
+  settings.iterations = 10000;
+  settings.milliseconds = 0;
+  settings.seed = 1;
+  settings.threads = std::thread::hardware_concurrency();
+  if (settings.threads < 1)
+  {
+    settings.threads = 1;
+  }
+  long solveNodes = 0;
+
+  for (int i = 1; i + 1 < argc; i += 2)
+  {
+    std::string flag = argv[i];
+    std::string value = argv[i + 1];
+
+    if (flag == "-map")
+    {
+      mapFilename = value;
+    }
+    else if (flag == "-n")
+    {
+      games = std::atoi(value.c_str());
+    }
+    else if (flag == "-iterations")
+    {
+      settings.iterations = std::atoi(value.c_str());
+      settings.milliseconds = 0;
+    }
+    else if (flag == "-ms")
+    {
+      settings.milliseconds = std::atoi(value.c_str());
+      settings.iterations = 0;
+    }
+    else if (flag == "-seed")
+    {
+      settings.seed = std::strtoull(value.c_str(), nullptr, 10);
+    }
+    else if (flag == "-threads")
+    {
+      settings.threads = std::atoi(value.c_str());
+    }
+    else if (flag == "-solve")
+    {
+      solveNodes = std::atol(value.c_str());
+      games = solveNodes > 0 ? games : 0;
+    }
+    else
+    {
+      games = 0;
+    }
+  }
+
+  if (argc % 2 == 0 || games <= 0 || settings.threads <= 0 ||
+      (settings.iterations <= 0 && settings.milliseconds <= 0))
+  {
+    std::cout << "Usage: probe [-map file] [-n games] "
+              << "[-iterations n | -ms milliseconds] [-seed n] [-threads n] "
+              << "[-solve max positions]\n";
+    return 1;
+  }
+
+  std::string map;
+  int rows;
+  int cols;
+  if (!Board::loadMap(mapFilename, map, rows, cols))
+  {
+    std::cout << "Could not read " << mapFilename << "\n";
+    return 1;
+  }
+
+  if (solveNodes > 0)
+  {
+    return solve(map, rows, cols, solveNodes) ? 0 : 1;
+  }
+
+  int wins = 0;
+  long stepsLeft = 0; // over every win
+  long iterations = 0;
+  double searchSeconds = 0;
+
+  for (int game = 0; game < games; game++)
+  {
+    MctsAgent agent(map, rows, cols, settings);
+    GameState state(new Board(map, rows, cols), false);
+    settings.seed++; // a different search for every game
+
+    for (int i = 0; i < MAX_ACTIONS &&
+         state.getPlayer()->getState() == Player::PLAYING; i++)
+    {
+      GameState::Action action = agent.chooseAction();
+      iterations += agent.getIterations();
+      if (agent.getIterationsPerSecond() > 0)
+      {
+        searchSeconds += agent.getIterations() / agent.getIterationsPerSecond();
+      }
+      agent.advance(action);
+      state.step(action);
+    }
+
+    bool won = state.getPlayer()->getState() == Player::WIN;
+    if (won)
+    {
+      wins++;
+      stepsLeft += state.getSteps();
+    }
+    std::cout << "Game " << game + 1 << ": " << (won ? "win" : "loss")
+              << ", " << state.getSteps() << " steps left\n";
+  }
+
+  std::cout << std::fixed << std::setprecision(1)
+            << "\nMap " << mapFilename << " (" << rows << "x" << cols << "), "
+            << settings.threads << " threads, ";
+  if (settings.iterations > 0)
+  {
+    std::cout << settings.iterations << " playouts per thread per action\n";
+  }
+  else
+  {
+    std::cout << settings.milliseconds << " ms per action\n";
+  }
+  std::cout << "Wins:          " << wins << " of " << games << " ("
+            << 100.0 * wins / games << "%)\n"
+            << "Steps left:    "
+            << (wins > 0 ? static_cast<double>(stepsLeft) / wins : 0)
+            << " on average in wins\n"
+            << "Search speed:  " << std::setprecision(0)
+            << (searchSeconds > 0 ? iterations / searchSeconds : 0)
+            << " playouts/sec\n";
+
+  return 0;
+}
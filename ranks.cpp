@@ -0,0 +1,258 @@
+/*********************************************************************
+** Program name: ranks.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Shows the leaderboard of a map from the game's leaderboard
+** log: the best wins, one per player, and optionally one player's rank. With
+** -bench, measures the leaderboard instead on a log of its own: how fast wins
+** are added with batched syncs, how long reading the log back takes, how long
+** rank and top-K lookups take, and how much compaction shrinks the log.
+**
+** Usage: ranks [-log file] [-map file] [-top n] [-player name]
+**        ranks -bench n [-maps n] [-players n] [-seed n]
+*********************************************************************/
+
+#include "leaderboard.hpp"
+#include "board.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  const char BENCH_FILENAME[] = "ranks.bench.log";
+  const long LOOKUPS = 1000000; // rank lookups timed
+  const long TOP_LOOKUPS = 100000; // top 10 lookups timed
+  const int MIN_STEPS = 5; // steps of the wins made up for the benchmark
+  const int MAX_STEPS = 22;
+
+  double secondsSince(std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  }
+
+  // Returns the size of the file at path, or 0 if there is none
+  long long fileSize(const std::string& path)
+  {
+    std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+    in.seekg(0, std::ios::end);
+    return in ? static_cast<long long>(in.tellg()) : 0;
+  }
+
+  // Shows the best count wins on the map with mapHash, and name's rank if
+  // name is not empty
+  void show(Leaderboard& leaderboard, unsigned long long mapHash, int count,
+            const std::string& name)
+  {
+    long players = leaderboard.getPlayers(mapHash);
+    std::cout << players << " players have escaped from this map\n";
+
+    std::vector<Leaderboard::Entry> top = leaderboard.getTop(mapHash, count);
+    for (int i = 0, n = top.size(); i < n; i++)
+    {
+      std::cout << std::setw(5) << leaderboard.getRankOf(mapHash, top[i].steps)
+                << ". " << std::left << std::setw(20) << top[i].name
+                << std::right << std::setw(4) << top[i].steps << " steps";
+      if (!top[i].replay.empty())
+      {
+        std::cout << "  " << top[i].replay;
+      }
+      std::cout << "\n";
+    }
+
+    if (!name.empty())
+    {
+      long rank = leaderboard.getRank(mapHash, name);
+      if (rank == 0)
+      {
+        std::cout << name << " has not escaped from this map\n";
+      }
+      else
+      {
+        std::cout << name << " is ranked " << rank << " of " << players
+                  << "\n";
+      }
+    }
+  }
+
+  // Adds wins random wins by players players over maps maps to a new log,
+  // then times reading it back, looking up ranks and compacting it
+  int bench(long wins, int maps, int players, unsigned long long seed)
+  {
+    std::remove(BENCH_FILENAME);
+    std::mt19937_64 random(seed);
+
+    std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+    {
+      Leaderboard leaderboard;
+      if (!leaderboard.open(BENCH_FILENAME))
+      {
+        std::cout << "Could not write " << BENCH_FILENAME << "\n";
+        return 1;
+      }
+
+      Leaderboard::Entry entry;
+      entry.time = 0;
+      for (long i = 0; i < wins; i++)
+      {
+        entry.mapHash = random() % maps;
+        entry.steps = MIN_STEPS + random() % (MAX_STEPS - MIN_STEPS + 1);
+        entry.name = "player" + std::to_string(random() % players);
+        entry.time++;
+        if (!leaderboard.add(entry))
+        {
+          std::cout << "Could not write " << BENCH_FILENAME << "\n";
+          return 1;
+        }
+      }
+      leaderboard.flush();
+      double seconds = secondsSince(start);
+      std::cout << std::fixed << std::setprecision(0)
+                << "Added:      " << wins << " wins in " << std::setprecision(2)
+                << seconds << " s, " << std::setprecision(0) << wins / seconds
+                << "/sec, synced every " << Leaderboard::BATCH_RECORDS
+                << " wins\n";
+      leaderboard.waitForCompaction();
+    }
+    long long logSize = fileSize(BENCH_FILENAME);
+
+    Leaderboard leaderboard;
+    start = std::chrono::steady_clock::now();
+    leaderboard.open(BENCH_FILENAME);
+    double seconds = secondsSince(start);
+    long records = leaderboard.getRecords();
+    std::cout << "Read back:  " << records << " records (" << logSize / 1024
+              << " KB) in "
+              << std::setprecision(2) << seconds << " s\n";
+
+    start = std::chrono::steady_clock::now();
+    long ranked = 0;
+    for (long i = 0; i < LOOKUPS; i++)
+    {
+      ranked += leaderboard.getRank(random() % maps,
+                                    "player" + std::to_string(random() %
+                                                              players)) > 0;
+    }
+    seconds = secondsSince(start);
+    std::cout << "Rank:       " << std::setprecision(3)
+              << seconds * 1e6 / LOOKUPS << " us per lookup, " << ranked
+              << " of " << LOOKUPS << " players ranked\n";
+
+    start = std::chrono::steady_clock::now();
+    for (long i = 0; i < TOP_LOOKUPS; i++)
+    {
+      leaderboard.getTop(random() % maps, 10);
+    }
+    seconds = secondsSince(start);
+    std::cout << "Top 10:     " << seconds * 1e6 / TOP_LOOKUPS
+              << " us per lookup\n";
+
+    start = std::chrono::steady_clock::now();
+    leaderboard.compact();
+    leaderboard.waitForCompaction();
+    seconds = secondsSince(start);
+    std::cout << "Compacted:  " << records << " records to "
+              << leaderboard.getRecords() << ", " << logSize / 1024 << " KB to "
+              << fileSize(BENCH_FILENAME) / 1024 << " KB in "
+              << std::setprecision(2) << seconds << " s\n";
+
+    std::remove(BENCH_FILENAME);
+    return 0;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  std::string logFilename = "leaderboard.log";
+  std::string mapFilename = "map.txt";
+  std::string name;
+  int count = 10;
+  long wins = 0;
+  int maps = 10;
+  int players = 100000;
+  unsigned long long seed = 1;
+
+  bool valid = argc % 2 == 1;
+  for (int i = 1; i + 1 < argc; i += 2)
+  {
+    std::string flag = argv[i];
+    std::string value = argv[i + 1];
+
+    if (flag == "-log")
+    {
+      logFilename = value;
+    }
+    else if (flag == "-map")
+    {
+      mapFilename = value;
+    }
+    else if (flag == "-top")
+    {
+      count = std::atoi(value.c_str());
+    }
+    else if (flag == "-player")
+    {
+      name = value;
+    }
+    else if (flag == "-bench")
+    {
+      wins = std::atol(value.c_str());
+      valid = valid && wins > 0;
+    }
+    else if (flag == "-maps")
+    {
+      maps = std::atoi(value.c_str());
+    }
+    else if (flag == "-players")
+    {
+      players = std::atoi(value.c_str());
+    }
+    else if (flag == "-seed")
+    {
+      seed = std::strtoull(value.c_str(), nullptr, 10);
+    }
+    else
+    {
+      valid = false;
+    }
+  }
+
+  if (!valid || count < 0 || maps <= 0 || players <= 0)
+  {
+    std::cout << "Usage: ranks [-log file] [-map file] [-top n] "
+              << "[-player name]\n"
+              << "       ranks -bench n [-maps n] [-players n] [-seed n]\n";
+    return 1;
+  }
+
+  if (wins > 0)
+  {
+    return bench(wins, maps, players, seed);
+  }
+
+  std::string map;
+  int rows;
+  int cols;
+  if (!Board::loadMap(mapFilename, map, rows, cols))
+  {
+    std::cout << "Could not read " << mapFilename << "\n";
+    return 1;
+  }
+
+  Leaderboard leaderboard;
+  if (!leaderboard.open(logFilename))
+  {
+    std::cout << "Could not read " << logFilename << "\n";
+    return 1;
+  }
+  show(leaderboard, Board::hashMap(map), count, name);
+  return 0;
+}
@@ -0,0 +1,484 @@
+/*********************************************************************
+** Program name: replay.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Record of one game: the map it was played on (by hash), the
+** cave seed for endless games, every action passed to GameState, including
+** answers to offers, and how the game ended. The rules are deterministic, so
+** playing the actions again on the same map reproduces the game exactly.
+**
+** Every KEYFRAME_INTERVAL turns the full game state is saved as a keyframe,
+** and the file has an index of them, so any turn of a long replay can be
+** reached by loading the keyframe before it and playing only the turns after.
+** Keyframes after the first leave out the undo history, which would make
+** each one larger than the last; each instead records how far playing on
+** from it stays exact, i.e. up to the first undo or redo that reaches back
+** past it.
+*********************************************************************/
+
+#include "replay.hpp"
+#include "gameState.hpp"
+#include "player.hpp"
+#include "board.hpp"
+#include "bytes.hpp"
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  const char MAGIC[] = "CAVEPLAY";
+  const int MAGIC_SIZE = 8;
+  const unsigned VERSION = 4;
+  const int INDEX_ENTRY_SIZE = 8 + 8 + 8 + 8; // turn, reach, offset, length
+
+  // Fields before the result's inventory: magic, version, map hash, rows,
+  // columns, endless, seed, then the result's state, steps, segment and the
+  // length of its inventory
+  const int HEADER_SIZE = MAGIC_SIZE + 4 + 8 + 4 + 4 + 1 + 8 + 1 + 4 + 4 + 4;
+
+  // Appends the next count bytes of in to text; returns false if in ends
+  // first
+  bool readMore(std::ifstream& in, std::string& text, std::size_t count)
+  {
+    std::size_t length = text.length();
+    text.resize(length + count);
+    if (count > 0)
+    {
+      in.read(&text[length], count);
+    }
+    return static_cast<bool>(in);
+  }
+}
+
+// --- Result::operator== ---
+bool Replay::Result::operator==(const Result& other) const
+{
+  return state == other.state && steps == other.steps &&
+         segment == other.segment && inventory == other.inventory;
+}
+
+// --- getResult ---
+// Returns how the game in state stands
+Replay::Result Replay::getResult(GameState& state)
+{
+  Player* player = state.getPlayer();
+  const Player::Inventory& inventory = player->getInventory();
+
+  Result result;
+  result.state = player->getState();
+  result.steps = state.getSteps();
+  result.segment = player->getSegment();
+  result.inventory.assign(inventory.begin(), inventory.end());
+  return result;
+}
+
+// --- Constructor ---
+Replay::Replay()
+{
+  clear();
+}
+
+// --- clear ---
+// Empties the replay and closes any file it was loaded from
+void Replay::clear()
+{
+  mapHash = Board::hashMap("");
+  rows = 0;
+  cols = 0;
+  endless = false;
+  seed = 0;
+  actions.clear();
+  keyframes.clear();
+  open.clear();
+  redoSize = 0;
+  if (replayFile.is_open())
+  {
+    replayFile.close();
+  }
+
+  result.state = Player::NONE;
+  result.steps = 0;
+  result.segment = 0;
+  result.inventory.clear();
+}
+
+// --- start ---
+// Clears the replay for the new game in state, which for an endless cave was
+// made from seed, and saves its first keyframe. That one keeps the history of
+// a game carried on from a save, so every turn can be reached from it.
+void Replay::start(GameState& state, unsigned long long seed)
+{
+  clear();
+
+  Board* board = state.getBoard();
+  mapHash = Board::hashMap(board->getMap());
+  rows = board->getRows();
+  cols = board->getCols();
+  endless = state.getPlayer()->isEndless();
+  this->seed = seed;
+
+  Keyframe first = { 0, -1, 0, 0, "" };
+  state.saveState(first.state, true);
+  keyframes.push_back(first);
+  redoSize = state.getRedoSize();
+}
+
+// --- addAction ---
+// Records an action just passed to GameState::step for state, adding a
+// keyframe every KEYFRAME_INTERVAL turns
+void Replay::addAction(GameState::Action action, GameState& state)
+{
+  actions.push_back(static_cast<unsigned char>(action));
+  closeKeyframes(action, state);
+
+  if (size() % KEYFRAME_INTERVAL == 0)
+  {
+    Keyframe keyframe = { size(), -1, 0, 0, "" };
+    state.saveState(keyframe.state, false);
+    keyframes.push_back(keyframe);
+
+    OpenKeyframe opened = { static_cast<int>(keyframes.size()) - 1,
+                            state.getHistorySize(), state.getRedoSize() };
+    open.push_back(opened);
+  }
+  redoSize = state.getRedoSize();
+}
+
+// --- closeKeyframes ---
+// Sets the reach of each open keyframe that action, just played on state,
+// takes back a turn from before (an undo) or carries out again a turn taken
+// back before (a redo), as a game loaded from it could do neither. While a
+// keyframe is open the game keeps at least its history and, until a new
+// action clears the redo list, its redo list, so later open keyframes have
+// at least as much of each and only the last few need checking.
+void Replay::closeKeyframes(GameState::Action action, GameState& state)
+{
+  std::size_t history = state.getHistorySize();
+  std::size_t redo = state.getRedoSize();
+  if (action != GameState::REDO && redo < redoSize)
+  {
+    for (std::size_t i = 0; i < open.size(); i++)
+    {
+      open[i].redo = 0; // cleared, so nothing from before can be redone
+    }
+  }
+
+  while (!open.empty() &&
+         (history < open.back().history ||
+          (action == GameState::REDO && redo < open.back().redo)))
+  {
+    keyframes[open.back().number].reach = size() - 1;
+    open.pop_back();
+  }
+}
+
+// --- finish ---
+// Records how the game ended
+void Replay::finish(GameState& state)
+{
+  result = getResult(state);
+}
+
+// --- save ---
+// Writes the replay to filename; returns false on failure
+bool Replay::save(const std::string& filename)
+{
+  // Read every keyframe first, in case the replay was loaded from filename
+  std::vector<std::string> states(keyframes.size());
+  for (int i = 0, n = keyframes.size(); i < n; i++)
+  {
+    if (!getKeyframe(i, states[i]))
+    {
+      return false;
+    }
+  }
+
+  std::string header(MAGIC, MAGIC_SIZE);
+  Bytes::putInt(header, VERSION, 4);
+  Bytes::putInt(header, mapHash, 8);
+  Bytes::putInt(header, rows, 4);
+  Bytes::putInt(header, cols, 4);
+  Bytes::putInt(header, endless ? 1 : 0, 1);
+  Bytes::putInt(header, seed, 8);
+
+  Bytes::putInt(header, result.state, 1);
+  Bytes::putInt(header, static_cast<unsigned>(result.steps), 4);
+  Bytes::putInt(header, result.segment, 4);
+  Bytes::putString(header, result.inventory);
+
+  Bytes::putInt(header, actions.size(), 8);
+  header.append(actions.begin(), actions.end());
+
+  // Keyframe index, then the keyframes themselves
+  Bytes::putInt(header, keyframes.size(), 4);
+  unsigned long long offset = header.length() +
+                              INDEX_ENTRY_SIZE * keyframes.size();
+  for (int i = 0, n = keyframes.size(); i < n; i++)
+  {
+    Bytes::putInt(header, keyframes[i].turn, 8);
+    Bytes::putInt(header, keyframes[i].reach < 0 ? size() : keyframes[i].reach,
+                  8);
+    Bytes::putInt(header, offset, 8);
+    Bytes::putInt(header, states[i].length(), 8);
+    offset += states[i].length();
+  }
+
+  std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+  if (!out)
+  {
+    return false;
+  }
+  out.write(header.data(), header.length());
+  for (int i = 0, n = states.size(); i < n; i++)
+  {
+    out.write(states[i].data(), states[i].length());
+  }
+
+  return static_cast<bool>(out);
+}
+
+// --- load ---
+// Reads a replay written by save, except for the keyframes, which are read
+// from the file when needed; returns false if the file is missing or not a
+// replay, leaving this replay empty
+bool Replay::load(const std::string& filename)
+{
+  clear();
+
+  std::ifstream& in = replayFile;
+  in.open(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!in)
+  {
+    return false;
+  }
+
+  in.seekg(0, std::ios::end);
+  unsigned long long fileSize = in.tellg();
+  in.seekg(0);
+
+  // The header, up to the length of the inventory, tells how much follows
+  std::string header;
+  std::size_t pos = MAGIC_SIZE;
+  unsigned long long version;
+  unsigned long long savedRows;
+  unsigned long long savedCols;
+  unsigned long long savedEndless;
+  unsigned long long state;
+  unsigned long long steps;
+  unsigned long long segment;
+  unsigned long long inventoryLength = 0;
+  std::size_t inventoryAt;
+  bool valid = readMore(in, header, HEADER_SIZE) &&
+               header.compare(0, MAGIC_SIZE, MAGIC) == 0 &&
+               Bytes::getInt(header, pos, 4, version) && version == VERSION &&
+               Bytes::getInt(header, pos, 8, mapHash) &&
+               Bytes::getInt(header, pos, 4, savedRows) &&
+               Bytes::getInt(header, pos, 4, savedCols) &&
+               Bytes::getInt(header, pos, 1, savedEndless) &&
+               Bytes::getInt(header, pos, 8, seed) &&
+               Bytes::getInt(header, pos, 1, state) &&
+               Bytes::getInt(header, pos, 4, steps) &&
+               Bytes::getInt(header, pos, 4, segment) &&
+               state <= Player::LOSE;
+  inventoryAt = pos;
+  valid = valid && Bytes::getInt(header, pos, 4, inventoryLength) &&
+          inventoryLength <=
+            static_cast<unsigned long long>(Player::INVENTORY_MAX);
+
+  // The inventory and the number of actions
+  unsigned long long count = 0;
+  pos = inventoryAt;
+  valid = valid && readMore(in, header, inventoryLength + 8) &&
+          Bytes::getString(header, pos, result.inventory) &&
+          Bytes::getInt(header, pos, 8, count) &&
+          count <= fileSize - header.length();
+  if (!valid)
+  {
+    clear();
+    return false; // not a replay, or truncated
+  }
+  rows = savedRows;
+  cols = savedCols;
+  endless = savedEndless != 0;
+  result.state = state;
+  result.steps = static_cast<int>(static_cast<unsigned>(steps));
+  result.segment = segment;
+
+  actions.resize(count);
+  if (count > 0)
+  {
+    in.read(reinterpret_cast<char*>(&actions[0]), count);
+  }
+  for (unsigned long long i = 0; i < count; i++)
+  {
+    valid = valid && actions[i] <= GameState::REDO;
+  }
+
+  // Keyframes must start at turn 0, be in order and lie within the file
+  std::string index;
+  pos = 0;
+  unsigned long long keyframeCount = 0;
+  valid = valid && readMore(in, index, 4) &&
+          Bytes::getInt(index, pos, 4, keyframeCount) &&
+          keyframeCount <= fileSize / INDEX_ENTRY_SIZE &&
+          readMore(in, index, keyframeCount * INDEX_ENTRY_SIZE);
+  for (unsigned long long i = 0; valid && i < keyframeCount; i++)
+  {
+    unsigned long long turn;
+    unsigned long long reach;
+    Keyframe keyframe;
+    Bytes::getInt(index, pos, 8, turn);
+    Bytes::getInt(index, pos, 8, reach);
+    Bytes::getInt(index, pos, 8, keyframe.offset);
+    Bytes::getInt(index, pos, 8, keyframe.length);
+
+    unsigned long long next = keyframes.empty() ? 0 :
+                              keyframes.back().turn + 1;
+    valid = turn <= count && turn >= next && (i > 0 || turn == 0) &&
+            reach >= turn && reach <= count &&
+            keyframe.offset <= fileSize &&
+            keyframe.length <= fileSize - keyframe.offset;
+    keyframe.turn = turn;
+    keyframe.reach = reach;
+    keyframes.push_back(keyframe);
+  }
+
+  if (!valid || !in || keyframes.empty())
+  {
+    clear();
+    return false;
+  }
+  return true;
+}
+
+// --- getMapHash ---
+unsigned long long Replay::getMapHash()
+{
+  return mapHash;
+}
+
+// --- getRows ---
+int Replay::getRows()
+{
+  return rows;
+}
+
+// --- getCols ---
+int Replay::getCols()
+{
+  return cols;
+}
+
+// --- isEndless ---
+bool Replay::isEndless()
+{
+  return endless;
+}
+
+// --- getSeed ---
+unsigned long long Replay::getSeed()
+{
+  return seed;
+}
+
+// --- size ---
+// Returns the number of actions recorded
+long Replay::size()
+{
+  return actions.size();
+}
+
+// --- getAction ---
+// Returns action number (starting at 0)
+GameState::Action Replay::getAction(long number)
+{
+  return static_cast<GameState::Action>(actions[number]);
+}
+
+// --- getResult ---
+const Replay::Result& Replay::getResult()
+{
+  return result;
+}
+
+// --- getKeyframeCount ---
+int Replay::getKeyframeCount()
+{
+  return keyframes.size();
+}
+
+// --- getKeyframeTurn ---
+// Returns the turn keyframe number was saved after
+long Replay::getKeyframeTurn(int number)
+{
+  return keyframes[number].turn;
+}
+
+// --- getKeyframe ---
+// Gets the saved game state of keyframe number, reading it from the file if
+// the replay was loaded; returns false if it cannot be read
+bool Replay::getKeyframe(int number, std::string& state)
+{
+  const Keyframe& keyframe = keyframes[number];
+  if (!replayFile.is_open())
+  {
+    state = keyframe.state;
+    return true;
+  }
+
+  state.assign(keyframe.length, ' ');
+  replayFile.clear();
+  replayFile.seekg(keyframe.offset);
+  if (keyframe.length > 0)
+  {
+    replayFile.read(&state[0], keyframe.length);
+  }
+  return static_cast<bool>(replayFile);
+}
+
+// --- seek ---
+// Puts the game in state, which must be on the replay's map or cave, at the
+// point just after turn actions, by loading the last keyframe at or before
+// turn that reaches it and playing the actions after it. Returns false if
+// there is no such turn or the keyframe cannot be loaded.
+bool Replay::seek(GameState& state, long turn)
+{
+  if (turn < 0 || turn > size() || keyframes.empty())
+  {
+    return false;
+  }
+
+  // Binary search for the last keyframe at or before turn
+  int low = 0;
+  int high = keyframes.size() - 1;
+  while (low < high)
+  {
+    int middle = (low + high + 1) / 2;
+    if (keyframes[middle].turn <= turn)
+    {
+      low = middle;
+    }
+    else
+    {
+      high = middle - 1;
+    }
+  }
+  while (low > 0 && keyframes[low].reach >= 0 && keyframes[low].reach < turn)
+  {
+    low--; // an undo or redo after it goes back past it
+  }
+
+  std::string saved;
+  if (!getKeyframe(low, saved) || !state.loadState(saved))
+  {
+    return false;
+  }
+
+  for (long i = keyframes[low].turn; i < turn; i++)
+  {
+    state.step(getAction(i));
+  }
+  return true;
+}
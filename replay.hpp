@@ -0,0 +1,107 @@
+/*********************************************************************
+** Program name: replay.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Record of one game: the map it was played on (by hash), the
+** cave seed for endless games, every action passed to GameState, including
+** answers to offers, and how the game ended. The rules are deterministic, so
+** playing the actions again on the same map reproduces the game exactly.
+**
+** Every KEYFRAME_INTERVAL turns the full game state is saved as a keyframe,
+** and the file has an index of them, so any turn of a long replay can be
+** reached by loading the keyframe before it and playing only the turns after.
+** Keyframes after the first leave out the undo history, which would make
+** each one larger than the last; each instead records how far playing on
+** from it stays exact, i.e. up to the first undo or redo that reaches back
+** past it.
+*********************************************************************/
+
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include "gameState.hpp"
+#include <fstream>
+#include <string>
+#include <vector>
+
+class Replay
+{
+public:
+  static const long KEYFRAME_INTERVAL = 1000; // turns between keyframes
+
+  // How a game ended, compared to check that a replay plays back the same
+  struct Result
+  {
+    int state; // Player::State
+    int steps;
+    int segment;
+    std::string inventory;
+
+    bool operator==(const Result& other) const;
+  };
+
+private:
+  unsigned long long mapHash;
+  int rows;
+  int cols;
+  bool endless;
+  unsigned long long seed; // seed of the endless cave
+  std::vector<unsigned char> actions; // one GameState::Action per byte
+  Result result;
+
+  // Keyframe of the game after turn actions; a recorded keyframe's state is
+  // kept in memory, a loaded one is read from offset in the file when needed
+  struct Keyframe
+  {
+    long turn;
+    long reach; // last turn reached exactly from it; -1 for every turn so far
+    unsigned long long offset;
+    unsigned long long length;
+    std::string state;
+  };
+
+  // A recorded keyframe whose reach is not yet known, with the lengths of the
+  // game's undo history and redo list from before it
+  struct OpenKeyframe
+  {
+    int number;
+    std::size_t history;
+    std::size_t redo;
+  };
+
+  std::vector<Keyframe> keyframes;
+  std::vector<OpenKeyframe> open;
+  std::size_t redoSize; // length of the redo list after the last action
+  std::ifstream replayFile;
+
+  void clear();
+  void closeKeyframes(GameState::Action action, GameState& state);
+
+public:
+  static Result getResult(GameState& state);
+
+  Replay();
+
+  void start(GameState& state, unsigned long long seed);
+  void addAction(GameState::Action action, GameState& state);
+  void finish(GameState& state);
+
+  bool save(const std::string& filename);
+  bool load(const std::string& filename);
+
+  unsigned long long getMapHash();
+  int getRows();
+  int getCols();
+  bool isEndless();
+  unsigned long long getSeed();
+  long size();
+  GameState::Action getAction(long number);
+  const Result& getResult();
+
+  int getKeyframeCount();
+  long getKeyframeTurn(int number);
+  bool getKeyframe(int number, std::string& state);
+  bool seek(GameState& state, long turn);
+};
+
+#endif
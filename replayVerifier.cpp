@@ -0,0 +1,150 @@
+/*********************************************************************
+** Program name: replayVerifier.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Checks replays submitted as proof of a win. Each replay is
+** played again from a new game with the same GameState rules the console
+** game uses, ignoring everything recorded but its actions, and must end in a
+** win that matches both its own recorded result and the number of steps
+** claimed for it. Replays are spread over worker threads, and every worker
+** plays its replays on one SharedBoard over the verifier's copy of the map,
+** reset between replays, so no board is built per replay.
+*********************************************************************/
+
+#include "replayVerifier.hpp"
+#include "board.hpp"
+#include "gameState.hpp"
+#include "player.hpp"
+#include "replay.hpp"
+#include "sharedBoard.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  const char* VERDICT_NAMES[] = { "verified", "unreadable", "wrong map",
+                                  "not a new game", "different result",
+                                  "not won", "wrong steps" };
+}
+
+// --- Constructor ---
+// Checks replays against map, a rows x cols map as read by Board::loadMap
+ReplayVerifier::ReplayVerifier(const std::string& map, int rows, int cols)
+  : map(Board::shareMap(map))
+{
+  this->rows = rows;
+  this->cols = cols;
+  mapHash = Board::hashMap(map);
+  turns = 0;
+
+  GameState state(new SharedBoard(this->map, rows, cols), false);
+  state.saveState(newGame, false);
+}
+
+// --- verify ---
+// Checks every submission on threads threads and sets verdicts to what was
+// found for each, in the same order
+void ReplayVerifier::verify(const std::vector<Submission>& submissions,
+                            int threads, std::vector<Verdict>& verdicts)
+{
+  verdicts.assign(submissions.size(), UNREADABLE);
+  turns = 0;
+  std::atomic<long> next(0);
+
+  std::vector<std::thread> workers;
+  for (int t = 1; t < threads; t++)
+  {
+    workers.push_back(std::thread(&ReplayVerifier::work, this,
+                                  std::cref(submissions), std::ref(verdicts),
+                                  std::ref(next)));
+  }
+  work(submissions, verdicts, next); // the calling thread works too
+  for (int t = 0, n = workers.size(); t < n; t++)
+  {
+    workers[t].join();
+  }
+}
+
+// --- work ---
+// Checks submissions, taking the next unchecked one each time, until none are
+// left
+void ReplayVerifier::work(const std::vector<Submission>& submissions,
+                          std::vector<Verdict>& verdicts,
+                          std::atomic<long>& next)
+{
+  GameState state(new SharedBoard(map, rows, cols), false);
+  long played = 0;
+  long count = submissions.size();
+  for (long i = next++; i < count; i = next++)
+  {
+    verdicts[i] = check(state, submissions[i], played);
+  }
+  turns += played;
+}
+
+// --- check ---
+// Plays the replay in submission on state and returns the verdict, adding
+// the turns played to played
+ReplayVerifier::Verdict ReplayVerifier::check(GameState& state,
+                                              const Submission& submission,
+                                              long& played)
+{
+  Replay replay;
+  if (!replay.load(submission.filename))
+  {
+    return UNREADABLE;
+  }
+  if (replay.isEndless() || replay.getMapHash() != mapHash ||
+      replay.getRows() != rows || replay.getCols() != cols)
+  {
+    return WRONG_MAP;
+  }
+
+  // A game carried on from a save starts from a state that cannot be
+  // checked; only games played from the start count
+  std::string start;
+  if (replay.getKeyframeCount() == 0 || replay.getKeyframeTurn(0) != 0 ||
+      !replay.getKeyframe(0, start) || start != newGame)
+  {
+    return NOT_NEW_GAME;
+  }
+
+  state.reset();
+  for (long i = 0, n = replay.size(); i < n; i++)
+  {
+    state.step(replay.getAction(i));
+  }
+  played += replay.size();
+
+  Replay::Result result = Replay::getResult(state);
+  if (!(result == replay.getResult()))
+  {
+    return DIFFERENT_RESULT;
+  }
+  if (result.state != Player::WIN)
+  {
+    return NOT_WON;
+  }
+  if (submission.steps >= 0 &&
+      GameState::START_STEPS - result.steps != submission.steps)
+  {
+    return WRONG_STEPS;
+  }
+  return VERIFIED;
+}
+
+// --- getTurns ---
+// Returns the number of turns played by the last call to verify
+long ReplayVerifier::getTurns()
+{
+  return turns;
+}
+
+// --- getVerdictName ---
+const char* ReplayVerifier::getVerdictName(Verdict verdict)
+{
+  return VERDICT_NAMES[verdict];
+}
@@ -0,0 +1,70 @@
+/*********************************************************************
+** Program name: replayVerifier.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Checks replays submitted as proof of a win. Each replay is
+** played again from a new game with the same GameState rules the console
+** game uses, ignoring everything recorded but its actions, and must end in a
+** win that matches both its own recorded result and the number of steps
+** claimed for it. Replays are spread over worker threads, and every worker
+** plays its replays on one SharedBoard over the verifier's copy of the map,
+** reset between replays, so no board is built per replay.
+*********************************************************************/
+
+#ifndef REPLAYVERIFIER_HPP
+#define REPLAYVERIFIER_HPP
+
+#include "gameState.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ReplayVerifier
+{
+public:
+  enum Verdict
+  {
+    VERIFIED,
+    UNREADABLE, // not a replay file
+    WRONG_MAP, // recorded on another map or in an endless cave
+    NOT_NEW_GAME, // carried on from a saved game, which cannot be checked
+    DIFFERENT_RESULT, // the actions do not end the way the replay says
+    NOT_WON,
+    WRONG_STEPS // won, but not in the steps claimed
+  };
+  static const int VERDICT_COUNT = 7;
+
+  // A replay and the steps its player claims to have won in
+  struct Submission
+  {
+    std::string filename;
+    int steps; // or -1 for a win in any number of steps
+  };
+
+private:
+  std::shared_ptr<const std::string> map; // shared by every worker's board
+  int rows;
+  int cols;
+  unsigned long long mapHash;
+  std::string newGame; // saved state of a game before its first action
+  std::atomic<long> turns; // played by the last call to verify
+
+  ReplayVerifier(const ReplayVerifier&) = delete;
+  ReplayVerifier& operator=(const ReplayVerifier&) = delete;
+
+  void work(const std::vector<Submission>& submissions,
+            std::vector<Verdict>& verdicts, std::atomic<long>& next);
+  Verdict check(GameState& state, const Submission& submission, long& played);
+
+public:
+  ReplayVerifier(const std::string& map, int rows, int cols);
+
+  void verify(const std::vector<Submission>& submissions, int threads,
+              std::vector<Verdict>& verdicts);
+  long getTurns();
+
+  static const char* getVerdictName(Verdict verdict);
+};
+
+#endif
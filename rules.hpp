@@ -0,0 +1,83 @@
+/*********************************************************************
+** Program name: rules.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Rule sets for games played in a GameBatch, chosen at compile
+** time. Each says how many steps a game starts with, whether running out of
+** them loses, how many items the player can carry, whether walking into a
+** wall uses up a step, and whether reaching the exit wins. A GameBatch of
+** StandardRules, HardcoreRules or PracticeRules has these folded into its
+** code, so a rule that is off costs nothing when stepping. RuntimeRules holds
+** the same settings as variables, for rule sets made up at run time and for
+** measuring what the fixed ones save.
+*********************************************************************/
+
+#ifndef RULES_HPP
+#define RULES_HPP
+
+#include "gameState.hpp"
+#include "player.hpp"
+
+// The rules of the game itself
+struct StandardRules
+{
+  static const char* name() { return "standard"; }
+  static constexpr int startSteps() { return GameState::START_STEPS; }
+  static constexpr bool limitSteps() { return true; }
+  static constexpr int inventoryMax() { return Player::INVENTORY_MAX; }
+  static constexpr bool bumpsCostSteps() { return false; }
+  static constexpr bool exitWins(int rocks) { return true; }
+};
+
+// Fewer steps, walking into a wall wastes one, and the exit only counts once
+// every rock picked up has filled a hole; the shipped map can still be won,
+// but only by its shortest route
+struct HardcoreRules
+{
+  static const char* name() { return "hardcore"; }
+  static constexpr int startSteps() { return 18; }
+  static constexpr bool limitSteps() { return true; }
+  static constexpr int inventoryMax() { return Player::INVENTORY_MAX; }
+  static constexpr bool bumpsCostSteps() { return true; }
+  static constexpr bool exitWins(int rocks) { return rocks == 0; }
+};
+
+// No step limit, for learning a map; the steps shown never run down
+struct PracticeRules
+{
+  static const char* name() { return "practice"; }
+  static constexpr int startSteps() { return GameState::START_STEPS; }
+  static constexpr bool limitSteps() { return false; }
+  static constexpr int inventoryMax() { return Player::INVENTORY_MAX; }
+  static constexpr bool bumpsCostSteps() { return false; }
+  static constexpr bool exitWins(int rocks) { return true; }
+};
+
+// Any of the above, chosen at run time
+struct RuntimeRules
+{
+  int steps;
+  bool limited;
+  int inventory;
+  bool bumps;
+  bool emptyHanded; // the exit only counts with no rocks carried
+
+  RuntimeRules() : steps(GameState::START_STEPS), limited(true),
+                   inventory(Player::INVENTORY_MAX), bumps(false),
+                   emptyHanded(false) {}
+
+  template <typename Rules>
+  explicit RuntimeRules(const Rules& rules)
+    : steps(rules.startSteps()), limited(rules.limitSteps()),
+      inventory(rules.inventoryMax()), bumps(rules.bumpsCostSteps()),
+      emptyHanded(!rules.exitWins(1)) {}
+
+  const char* name() const { return "runtime"; }
+  int startSteps() const { return steps; }
+  bool limitSteps() const { return limited; }
+  int inventoryMax() const { return inventory; }
+  bool bumpsCostSteps() const { return bumps; }
+  bool exitWins(int rocks) const { return !emptyHanded || rocks == 0; }
+};
+
+#endif
@@ -0,0 +1,141 @@
+/*********************************************************************
+** Program name: savedGame.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Saves a game in progress to a file and loads it again. The
+** file names the map (by hash) or endless cave (by seed) and holds the state
+** from GameState::saveState, in which only the spaces that differ from the
+** map are stored, so its size depends on how much has changed rather than on
+** the size of the map.
+*********************************************************************/
+
+#include "savedGame.hpp"
+#include "board.hpp"
+#include "bytes.hpp"
+#include "gameState.hpp"
+#include "player.hpp"
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+  const char MAGIC[] = "CAVESAVE";
+  const int MAGIC_SIZE = 8;
+  const unsigned VERSION = 2;
+
+  // Reads the whole of filename into contents; returns false if it cannot be
+  // opened
+  bool readFile(const std::string& filename, std::string& contents)
+  {
+    std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!in)
+    {
+      return false;
+    }
+    contents.assign(std::istreambuf_iterator<char>(in),
+                    std::istreambuf_iterator<char>());
+    return true;
+  }
+
+  // Reads the header of a saved game from in into info and moves pos past it;
+  // returns false if in is not a saved game
+  bool readHeader(const std::string& in, std::size_t& pos,
+                  SavedGame::Info& info)
+  {
+    unsigned long long version;
+    unsigned long long rows;
+    unsigned long long cols;
+    unsigned long long endless;
+    if (in.compare(0, MAGIC_SIZE, MAGIC) != 0)
+    {
+      return false;
+    }
+    pos = MAGIC_SIZE;
+    if (!Bytes::getInt(in, pos, 4, version) || version != VERSION ||
+        !Bytes::getInt(in, pos, 8, info.mapHash) ||
+        !Bytes::getInt(in, pos, 4, rows) || !Bytes::getInt(in, pos, 4, cols) ||
+        !Bytes::getInt(in, pos, 1, endless) ||
+        !Bytes::getInt(in, pos, 8, info.seed))
+    {
+      return false;
+    }
+
+    info.rows = rows;
+    info.cols = cols;
+    info.endless = endless != 0;
+    return true;
+  }
+}
+
+// --- save ---
+// Writes the game in state, which for an endless cave was made from seed, to
+// filename; returns false on failure
+bool SavedGame::save(const std::string& filename, GameState& state,
+                     unsigned long long seed)
+{
+  std::string saved;
+  state.saveState(saved, true);
+
+  Board* board = state.getBoard();
+  std::string header(MAGIC, MAGIC_SIZE);
+  Bytes::putInt(header, VERSION, 4);
+  Bytes::putInt(header, Board::hashMap(board->getMap()), 8);
+  Bytes::putInt(header, board->getRows(), 4);
+  Bytes::putInt(header, board->getCols(), 4);
+  Bytes::putInt(header, state.getPlayer()->isEndless() ? 1 : 0, 1);
+  Bytes::putInt(header, seed, 8);
+  Bytes::putInt(header, saved.length(), 8);
+
+  std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+  if (!out)
+  {
+    return false;
+  }
+  out.write(header.data(), header.length());
+  out.write(saved.data(), saved.length());
+
+  return static_cast<bool>(out);
+}
+
+// --- readInfo ---
+// Reads which map or cave the game saved in filename is on, so that a game on
+// it can be set up for load; returns false if filename is not a saved game
+bool SavedGame::readInfo(const std::string& filename, Info& info)
+{
+  std::string in;
+  std::size_t pos = 0;
+  return readFile(filename, in) && readHeader(in, pos, info);
+}
+
+// --- load ---
+// Carries on the game saved in filename in state, which must be a game on the
+// same map or endless cave. Returns false, changing nothing, if the file is
+// not a saved game or was saved on a different map or cave.
+bool SavedGame::load(const std::string& filename, GameState& state)
+{
+  std::string in;
+  std::size_t pos = 0;
+  Info info;
+  if (!readFile(filename, in) || !readHeader(in, pos, info))
+  {
+    return false;
+  }
+
+  Board* board = state.getBoard();
+  if (info.endless != state.getPlayer()->isEndless() ||
+      info.rows != board->getRows() || info.cols != board->getCols() ||
+      info.mapHash != Board::hashMap(board->getMap()))
+  {
+    return false;
+  }
+
+  unsigned long long length;
+  if (!Bytes::getInt(in, pos, 8, length) || length > in.length() - pos)
+  {
+    return false; // cut short
+  }
+
+  return state.loadState(in.substr(pos, length));
+}
@@ -0,0 +1,36 @@
+/*********************************************************************
+** Program name: savedGame.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Saves a game in progress to a file and loads it again. The
+** file names the map (by hash) or endless cave (by seed) and holds the state
+** from GameState::saveState, in which only the spaces that differ from the
+** map are stored, so its size depends on how much has changed rather than on
+** the size of the map.
+*********************************************************************/
+
+#ifndef SAVEDGAME_HPP
+#define SAVEDGAME_HPP
+
+#include "gameState.hpp"
+#include <string>
+
+class SavedGame
+{
+public:
+  struct Info
+  {
+    unsigned long long mapHash;
+    int rows;
+    int cols;
+    bool endless;
+    unsigned long long seed; // seed of the endless cave
+  };
+
+  static bool save(const std::string& filename, GameState& state,
+                   unsigned long long seed);
+  static bool readInfo(const std::string& filename, Info& info);
+  static bool load(const std::string& filename, GameState& state);
+};
+
+#endif
@@ -0,0 +1,123 @@
+/*********************************************************************
+** Program name: server.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Runs the game server until interrupted, then reports how many
+** players it served. Players connect with any line-based client, e.g.
+** "nc 127.0.0.1 7777" or "nc -U cave.sock", and play as in the console game;
+** every reply ends with the prompt "> ".
+**
+** Usage: server [-map file] [-port n | -unix path] [-threads n]
+*********************************************************************/
+
+#include "gameServer.hpp"
+#include "board.hpp"
+#include <sys/resource.h>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+  GameServer* running = nullptr; // for the signal handler
+
+  void handleSignal(int)
+  {
+    if (running != nullptr)
+    {
+      running->stop();
+    }
+  }
+
+  // Raises the limit on open files as far as allowed, since every player
+  // needs one
+  void raiseFileLimit()
+  {
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+    {
+      limit.rlim_cur = limit.rlim_max;
+      setrlimit(RLIMIT_NOFILE, &limit);
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  std::string mapFilename = "map.txt";
+  std::string unixPath;
+  int port = 7777;
+  int threads = 1;
+
+  bool valid = argc % 2 == 1;
+  for (int i = 1; valid && i + 1 < argc; i += 2)
+  {
+    std::string flag = argv[i];
+    std::string value = argv[i + 1];
+
+    if (flag == "-map")
+    {
+      mapFilename = value;
+    }
+    else if (flag == "-port")
+    {
+      port = std::atoi(value.c_str());
+    }
+    else if (flag == "-unix")
+    {
+      unixPath = value;
+    }
+    else if (flag == "-threads")
+    {
+      threads = std::atoi(value.c_str());
+    }
+    else
+    {
+      valid = false;
+    }
+  }
+
+  if (!valid || port <= 0 || port > 65535 || threads < 1)
+  {
+    std::cout << "Usage: server [-map file] [-port n | -unix path] "
+              << "[-threads n]\n";
+    return 1;
+  }
+
+  std::string map;
+  int rows;
+  int cols;
+  if (!Board::loadMap(mapFilename, map, rows, cols))
+  {
+    std::cout << "Could not read " << mapFilename << "\n";
+    return 1;
+  }
+
+  GameServer server(map, rows, cols);
+  bool listening = unixPath.empty() ? server.listenTcp(port) :
+                                      server.listenUnix(unixPath);
+  if (!listening)
+  {
+    std::cout << "Could not listen on "
+              << (unixPath.empty() ? "port " + std::to_string(port) : unixPath)
+              << "\n";
+    return 1;
+  }
+
+  raiseFileLimit();
+  running = &server;
+  std::signal(SIGINT, handleSignal);
+  std::signal(SIGTERM, handleSignal);
+
+  std::cout << "Serving " << mapFilename << " on "
+            << (unixPath.empty() ? "127.0.0.1:" + std::to_string(port) :
+                                   unixPath)
+            << " with " << threads << " threads; Ctrl+C to stop\n";
+  server.run(threads);
+
+  std::cout << "\nServed " << server.getSessions() << " sessions, "
+            << server.getGames() << " games, " << server.getTurns()
+            << " turns\n";
+  return 0;
+}
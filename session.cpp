@@ -0,0 +1,519 @@
+/*********************************************************************
+** Program name: session.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: One player's visit to the game server. Where the console game
+** waits for input in getChar and Menu::showMenu, a session is a state machine
+** that is handed each line the player sends and returns the reply, so one
+** thread can serve many players without blocking on any of them. The menus,
+** rules and messages are the same as in the console game, and the player
+** may also join the cave shared by everyone on the server or watch another
+** player's game.
+*********************************************************************/
+
+#include "session.hpp"
+#include "board.hpp"
+#include "broadcast.hpp"
+#include "endlessBoard.hpp"
+#include "sharedBoard.hpp"
+#include "sharedCave.hpp"
+#include "gameState.hpp"
+#include "menu.hpp"
+#include "messages.hpp"
+#include "player.hpp"
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+const char Session::PROMPT[] = "> ";
+
+namespace
+{
+  const std::size_t MAX_LISTED = 20; // games listed to choose one to watch
+}
+
+// --- Constructor ---
+// Starts a session on map, shared read only with the other sessions; the
+// player may also join cave, which must outlive the session, and an endless
+// cave played in this session is made from seed. Games are listed in
+// broadcasts under the session's number for others to watch.
+Session::Session(const std::shared_ptr<const std::string>& map, int rows,
+                 int cols, SharedCave* cave, BroadcastList* broadcasts,
+                 long number, unsigned long long seed)
+  : map(map)
+{
+  this->rows = rows;
+  this->cols = cols;
+  this->cave = cave;
+  this->broadcasts = broadcasts;
+  this->number = number;
+  this->seed = seed;
+  watchedNumber = 0;
+  endless = false;
+  caver = nullptr;
+  shared = false;
+  phase = MAIN_MENU;
+  turns = 0;
+  games = 0;
+}
+
+// --- Destructor ---
+// Leaves the shared cave, freeing the player's space for the others, and
+// ends the broadcast of the game being played
+Session::~Session()
+{
+  endBroadcast();
+  if (caver != nullptr)
+  {
+    cave->leave(caver);
+  }
+}
+
+// --- start ---
+// Sets reply to the greeting and main menu sent when the player connects
+void Session::start(std::string& reply)
+{
+  out.str("");
+  out << "--- Welcome to Cave Escape! ---\n";
+  showMainMenu();
+  out << PROMPT;
+  reply = out.str();
+}
+
+// --- input ---
+// Handles one line sent by the player and sets reply to the text to send
+// back, which ends with PROMPT unless the player has left. A line that is not
+// a valid choice is ignored, as in the console game.
+void Session::input(const std::string& line, std::string& reply)
+{
+  out.str("");
+  turns++;
+
+  char key = line.length() == 1 ? line[0] : '\0';
+  switch (phase)
+  {
+    case MAIN_MENU:
+      if (key == '1' || key == '2')
+      {
+        newGame(key == '2');
+      }
+      else if (key == '3')
+      {
+        joinCave();
+      }
+      else if (key == '4')
+      {
+        showGames();
+      }
+      else if (key == '5')
+      {
+        phase = CLOSED;
+      }
+      break;
+    case PLAYING:
+      if (key == 'W' || key == 'w')
+      {
+        takeAction(GameState::MOVE_UP);
+      }
+      else if (key == 'A' || key == 'a')
+      {
+        takeAction(GameState::MOVE_LEFT);
+      }
+      else if (key == 'S' || key == 's')
+      {
+        takeAction(GameState::MOVE_DOWN);
+      }
+      else if (key == 'D' || key == 'd')
+      {
+        takeAction(GameState::MOVE_RIGHT);
+      }
+      else if (key == 'E' || key == 'e')
+      {
+        takeAction(GameState::INSPECT);
+      }
+      else if (key == 'I' || key == 'i')
+      {
+        takeAction(GameState::INVENTORY);
+      }
+      else if (key == 'Q' || key == 'q')
+      {
+        takeAction(GameState::QUIT);
+      }
+      else if (!endless && !shared && (key == 'U' || key == 'u'))
+      {
+        takeAction(GameState::UNDO);
+      }
+      else if (!endless && !shared && (key == 'R' || key == 'r'))
+      {
+        takeAction(GameState::REDO);
+      }
+      break;
+    case OFFER:
+      if (key == '1' || key == '2')
+      {
+        takeAction(key == '1' ? GameState::ACCEPT : GameState::DECLINE);
+      }
+      break;
+    case GAME_OVER:
+      if (key == '1' && shared)
+      {
+        joinCave();
+      }
+      else if (key == '1')
+      {
+        newGame(endless);
+      }
+      else if (key == '2')
+      {
+        phase = CLOSED;
+      }
+      break;
+    case CHOOSE_GAME:
+      watchGame(line);
+      break;
+    case WATCHING:
+      watched.reset();
+      out << "\n";
+      showMainMenu();
+      phase = MAIN_MENU;
+      break;
+    case CLOSED:
+      break;
+  }
+
+  if (phase == CLOSED)
+  {
+    out << "Goodbye.\n";
+  }
+  else if (phase != WATCHING)
+  {
+    out << PROMPT;
+  }
+  reply = out.str();
+}
+
+// --- stopWatching ---
+// Sets reply to the text to send once the game being watched has ended, and
+// goes back to the main menu
+void Session::stopWatching(std::string& reply)
+{
+  out.str("");
+  watched.reset();
+  out << "\nGame " << watchedNumber << " is over.\n";
+  showMainMenu();
+  out << PROMPT;
+  phase = MAIN_MENU;
+  reply = out.str();
+}
+
+// --- showMainMenu ---
+void Session::showMainMenu()
+{
+  Menu mainMenu(5);
+  mainMenu.setPrompt(1, "Play");
+  mainMenu.setPrompt(2, "Play endless cave");
+  mainMenu.setPrompt(3, "Join the shared cave");
+  mainMenu.setPrompt(4, "Watch a game");
+  mainMenu.setPrompt(5, "Exit");
+  mainMenu.print(out);
+}
+
+// --- showGameOverMenu ---
+void Session::showGameOverMenu()
+{
+  Menu gameOverMenu(2);
+  gameOverMenu.setPrompt(1, "Play again");
+  gameOverMenu.setPrompt(2, "Quit");
+  gameOverMenu.print(out);
+}
+
+// --- showOfferMenu ---
+// Shows the choice offered on inspecting a space
+void Session::showOfferMenu()
+{
+  Menu offerMenu(2);
+  if (getOffer() == Space::MINE_ROCKS)
+  {
+    offerMenu.setPrompt(1, "Mine the rocks");
+  }
+  else
+  {
+    offerMenu.setPrompt(1, "Take the pickaxe");
+  }
+  offerMenu.setPrompt(2, "Do nothing");
+  offerMenu.print(out);
+}
+
+// --- showTurn ---
+// Shows the steps left, the board and the controls, and sends the same view
+// to anyone watching
+void Session::showTurn()
+{
+  int steps = shared ? caver->getSteps() : state->getSteps();
+  std::string view = drawGame(std::to_string(static_cast<long long>(steps)) +
+                              " steps remaining\n");
+  out << view;
+  if (broadcast)
+  {
+    broadcast->publish("Game " + std::to_string(static_cast<long long>(number)) +
+                       ": " + view + "Send any line to stop watching.\n");
+  }
+  printControls(out, !endless && !shared);
+}
+
+// --- showGames ---
+// Lists the games being played by others, to choose one to watch
+void Session::showGames()
+{
+  std::vector<long> numbers = broadcasts->list(MAX_LISTED + 1);
+  std::size_t listed = 0;
+  for (std::size_t i = 0; i < numbers.size() && listed < MAX_LISTED; i++)
+  {
+    if (numbers[i] != number)
+    {
+      out << (listed == 0 ? "\nGames being played:" : "") << " " << numbers[i];
+      listed++;
+    }
+  }
+
+  if (listed == 0)
+  {
+    out << "\nNo one else is playing right now.\n";
+    showMainMenu();
+    phase = MAIN_MENU;
+    return;
+  }
+  out << "\nEnter the number of a game to watch, or 0 to go back.\n";
+  phase = CHOOSE_GAME;
+}
+
+// --- drawGame ---
+// Returns status followed by the board as the player sees it
+std::string Session::drawGame(const std::string& status)
+{
+  std::ostringstream view;
+  view << status;
+  if (shared)
+  {
+    cave->print(caver, view);
+  }
+  else
+  {
+    state->getBoard()->print(view);
+  }
+  return view.str();
+}
+
+// --- watchGame ---
+// Starts watching the game numbered in line, or goes back to the main menu on
+// 0
+void Session::watchGame(const std::string& line)
+{
+  long chosen = std::atol(line.c_str());
+  if (chosen == 0)
+  {
+    out << "\n";
+    showMainMenu();
+    phase = MAIN_MENU;
+    return;
+  }
+
+  std::shared_ptr<Broadcast> found;
+  if (chosen != number)
+  {
+    found = broadcasts->find(chosen);
+  }
+  if (!found)
+  {
+    out << "\nGame " << chosen << " is not being played.\n";
+    showGames();
+    return;
+  }
+
+  watched = found;
+  watchedNumber = chosen;
+  phase = WATCHING;
+}
+
+// --- newGame ---
+// Starts a game on the map, or in the session's endless cave
+void Session::newGame(bool endless)
+{
+  Board* board;
+  if (endless)
+  {
+    board = new EndlessBoard(seed);
+  }
+  else
+  {
+    board = new SharedBoard(map, rows, cols);
+  }
+
+  this->endless = endless;
+  shared = false;
+  state.reset(new GameState(board, endless));
+  games++;
+  startBroadcast();
+
+  out << "\n";
+  printIntro(out, endless, seed);
+  showTurn();
+  phase = PLAYING;
+}
+
+// --- joinCave ---
+// Puts the player in the shared cave, on a new space if they were in it
+// before, or back at the main menu if it is full
+void Session::joinCave()
+{
+  if (caver != nullptr)
+  {
+    cave->leave(caver);
+  }
+  caver = cave->join();
+  if (caver == nullptr)
+  {
+    shared = false;
+    endBroadcast();
+    out << "\nThe shared cave is full; try again later.\n";
+    showMainMenu();
+    phase = MAIN_MENU;
+    return;
+  }
+
+  shared = true;
+  games++;
+  startBroadcast();
+
+  out << "\n";
+  printCaveIntro(out);
+  showTurn();
+  phase = PLAYING;
+}
+
+// --- takeAction ---
+// Carries out action and shows what happened; an inspection and the answer to
+// its offer are undone and redone together, as in the console game
+void Session::takeAction(GameState::Action action)
+{
+  if (shared)
+  {
+    printEvents(out, caver->getPlayer(), cave->step(caver, action).events);
+    finishTurn();
+    return;
+  }
+
+  const GameState::Outcome* outcome = &state->step(action);
+  printEvents(out, state->getPlayer(), outcome->events);
+
+  if (action == GameState::UNDO || action == GameState::REDO)
+  {
+    if (!outcome->valid)
+    {
+      out << (action == GameState::UNDO ? "\nNothing to undo.\n" :
+                                          "\nNothing to redo.\n");
+    }
+    while (outcome->valid && outcome->offer != Space::NO_OFFER)
+    {
+      outcome = &state->step(action);
+      printEvents(out, state->getPlayer(), outcome->events);
+    }
+  }
+
+  finishTurn();
+}
+
+// --- finishTurn ---
+// Moves on to whatever the player must choose next
+void Session::finishTurn()
+{
+  if (getOffer() != Space::NO_OFFER)
+  {
+    phase = OFFER;
+    showOfferMenu();
+  }
+  else if (getPlayer()->getState() != Player::PLAYING)
+  {
+    phase = GAME_OVER;
+    std::ostringstream result;
+    printResult(result, getPlayer());
+    out << result.str();
+    if (broadcast)
+    {
+      broadcast->publish("Game " +
+                         std::to_string(static_cast<long long>(number)) +
+                         ": " + drawGame(result.str()));
+    }
+    endBroadcast();
+    state.reset(); // the game is not needed while waiting for an answer
+    showGameOverMenu();
+  }
+  else
+  {
+    phase = PLAYING;
+    showTurn();
+  }
+}
+
+// --- startBroadcast ---
+// Lists the game just started for others to watch, in place of the last one
+void Session::startBroadcast()
+{
+  endBroadcast();
+  broadcast.reset(new Broadcast());
+  broadcasts->add(number, broadcast);
+}
+
+// --- endBroadcast ---
+// Ends the broadcast of the game, if there is one; its watchers are sent what
+// they have not seen yet and then told that it is over
+void Session::endBroadcast()
+{
+  if (broadcast)
+  {
+    broadcast->close();
+    broadcasts->remove(number, broadcast);
+    broadcast.reset();
+  }
+}
+
+// --- getPlayer ---
+// Returns the player of the game being played, shared or not
+Player* Session::getPlayer()
+{
+  return shared ? caver->getPlayer() : state->getPlayer();
+}
+
+// --- getOffer ---
+Space::Offer Session::getOffer()
+{
+  return shared ? caver->getOffer() : state->getOffer();
+}
+
+// --- getPhase ---
+Session::Phase Session::getPhase()
+{
+  return phase;
+}
+
+// --- getWatched ---
+// Returns the game being watched, or nullptr if none is
+std::shared_ptr<Broadcast> Session::getWatched()
+{
+  return watched;
+}
+
+// --- getTurns ---
+// Returns the number of lines the player has sent
+long Session::getTurns()
+{
+  return turns;
+}
+
+// --- getGames ---
+int Session::getGames()
+{
+  return games;
+}
@@ -0,0 +1,98 @@
+/*********************************************************************
+** Program name: session.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: One player's visit to the game server. Where the console game
+** waits for input in getChar and Menu::showMenu, a session is a state machine
+** that is handed each line the player sends and returns the reply, so one
+** thread can serve many players without blocking on any of them. The menus,
+** rules and messages are the same as in the console game, and the player
+** may also join the cave shared by everyone on the server or watch another
+** player's game.
+*********************************************************************/
+
+#ifndef SESSION_HPP
+#define SESSION_HPP
+
+#include "broadcast.hpp"
+#include "gameState.hpp"
+#include "player.hpp"
+#include "sharedCave.hpp"
+#include "space.hpp"
+#include <memory>
+#include <sstream>
+#include <string>
+
+class Session
+{
+public:
+  static const char PROMPT[]; // ends every reply that waits for input
+
+  // What the session is waiting for the player to choose
+  enum Phase
+  {
+    MAIN_MENU,
+    PLAYING, // an action key
+    OFFER, // an answer to an offer made by inspecting
+    GAME_OVER, // whether to play again
+    CHOOSE_GAME, // the number of a game to watch
+    WATCHING, // any line, to stop watching
+    CLOSED // the player has left
+  };
+
+private:
+  std::shared_ptr<const std::string> map; // shared by every session on the server
+  int rows;
+  int cols;
+  unsigned long long seed; // seed of this session's endless cave
+  bool endless;
+  SharedCave* cave; // played by everyone on the server
+  SharedCave::Caver* caver; // this player in the cave, if they joined it
+  bool shared; // playing in the cave rather than a game of their own
+  BroadcastList* broadcasts; // games on the server that can be watched
+  long number; // of this session, which names its games to watchers
+  std::shared_ptr<Broadcast> broadcast; // of the game being played
+  std::shared_ptr<Broadcast> watched; // game being watched
+  long watchedNumber;
+  Phase phase;
+  std::unique_ptr<GameState> state;
+  std::ostringstream out; // reply being written
+  long turns; // lines handled
+  int games;
+
+  Session(const Session&) = delete;
+  Session& operator=(const Session&) = delete;
+
+  void showMainMenu();
+  void showGameOverMenu();
+  void showOfferMenu();
+  void showTurn();
+  void showGames();
+  std::string drawGame(const std::string& status);
+  void newGame(bool endless);
+  void joinCave();
+  void startBroadcast();
+  void endBroadcast();
+  void watchGame(const std::string& line);
+  void takeAction(GameState::Action action);
+  void finishTurn();
+  Player* getPlayer();
+  Space::Offer getOffer();
+
+public:
+  Session(const std::shared_ptr<const std::string>& map, int rows, int cols,
+          SharedCave* cave, BroadcastList* broadcasts, long number,
+          unsigned long long seed);
+  ~Session();
+
+  void start(std::string& reply);
+  void input(const std::string& line, std::string& reply);
+  void stopWatching(std::string& reply);
+
+  Phase getPhase();
+  std::shared_ptr<Broadcast> getWatched();
+  long getTurns();
+  int getGames();
+};
+
+#endif
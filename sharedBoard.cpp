@@ -0,0 +1,211 @@
+/*********************************************************************
+** Program name: sharedBoard.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: A board that shares its map, read only, with every other board
+** made from the same map. Spaces are created from the map only when the player
+** comes next to them or they are asked for, so a board holds just the part of
+** the map its player has reached, including every space the player changed.
+*********************************************************************/
+
+#include "sharedBoard.hpp"
+#include "space.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+  const int VIEW_ROWS = 15; // rows and columns printed around the player
+  const int VIEW_COLS = 31;
+}
+
+// --- Constructor ---
+// Shares map, which has rows x cols symbols row by row, and puts the player at
+// [1,1]
+SharedBoard::SharedBoard(const std::shared_ptr<const std::string>& map,
+                         int rows, int cols)
+  : Board(rows, cols)
+{
+  this->map = map;
+
+  playerRow = 1;
+  playerCol = 1;
+  playerSpace = getSpace(playerRow, playerCol);
+  playerSpace->setPlayer(true);
+}
+
+// --- Destructor ---
+// Deletes the created spaces; none are deleted before, so pointers held by the
+// game rules and their history stay valid for the life of the board
+SharedBoard::~SharedBoard()
+{
+  for (std::unordered_map<int, Space*>::iterator it = spaces.begin();
+       it != spaces.end(); ++it)
+  {
+    delete it->second;
+  }
+}
+
+// --- reach ---
+// Returns the space at [row, col], creating it from the map and linking it to
+// the created spaces around it if it does not exist yet, or nullptr if it is
+// off the board
+Space* SharedBoard::reach(int row, int col)
+{
+  if (row < 0 || row >= boardRows || col < 0 || col >= boardCols)
+  {
+    return nullptr;
+  }
+
+  int cell = row * boardCols + col;
+  std::unordered_map<int, Space*>::iterator found = spaces.find(cell);
+  if (found != spaces.end())
+  {
+    return found->second;
+  }
+
+  Space* space = createSpace((*map)[cell]);
+  spaces[cell] = space;
+
+  const Space::Direction directions[] = { Space::UP, Space::DOWN, Space::LEFT,
+                                          Space::RIGHT };
+  const Space::Direction opposites[] = { Space::DOWN, Space::UP, Space::RIGHT,
+                                         Space::LEFT };
+  const int rowSteps[] = { -1, 1, 0, 0 };
+  const int colSteps[] = { 0, 0, -1, 1 };
+  for (int i = 0; i < 4; i++)
+  {
+    int nextRow = row + rowSteps[i];
+    int nextCol = col + colSteps[i];
+    if (nextRow < 0 || nextRow >= boardRows || nextCol < 0 ||
+        nextCol >= boardCols)
+    {
+      continue;
+    }
+    found = spaces.find(nextRow * boardCols + nextCol);
+    if (found != spaces.end())
+    {
+      space->setAdjacent(directions[i], found->second);
+      found->second->setAdjacent(opposites[i], space);
+    }
+  }
+  return space;
+}
+
+// --- surround ---
+// Creates the spaces next to [row, col], so moves from it see every space
+// they could reach
+void SharedBoard::surround(int row, int col)
+{
+  reach(row - 1, col);
+  reach(row + 1, col);
+  reach(row, col - 1);
+  reach(row, col + 1);
+}
+
+// --- getSpaceCount ---
+// Returns the number of spaces created so far
+std::size_t SharedBoard::getSpaceCount()
+{
+  return spaces.size();
+}
+
+// --- getSpace ---
+// Return the space at [row, col], creating it and the spaces next to it if
+// needed, or nullptr if there is no such space
+Space* SharedBoard::getSpace(int row, int col)
+{
+  Space* space = reach(row, col);
+  if (space != nullptr)
+  {
+    surround(row, col);
+  }
+  return space;
+}
+
+// --- locate ---
+// Finds the row and column of space; any space but the player's is searched
+// for among the created spaces
+void SharedBoard::locate(Space* space, int& row, int& col)
+{
+  row = 0;
+  col = 0;
+  if (space == playerSpace)
+  {
+    row = playerRow;
+    col = playerCol;
+    return;
+  }
+  for (std::unordered_map<int, Space*>::iterator it = spaces.begin();
+       it != spaces.end(); ++it)
+  {
+    if (it->second == space)
+    {
+      row = it->first / boardCols;
+      col = it->first % boardCols;
+      return;
+    }
+  }
+}
+
+// --- print ---
+// Prints the part of the board around the player, or all of it if it is
+// small; spaces not created yet are shown as they are on the map
+void SharedBoard::print(std::ostream& out)
+{
+  int rows = std::min(boardRows, VIEW_ROWS);
+  int cols = std::min(boardCols, VIEW_COLS);
+  int firstRow = std::max(0, std::min(playerRow - rows / 2, boardRows - rows));
+  int firstCol = std::max(0, std::min(playerCol - cols / 2, boardCols - cols));
+
+  out << "\n";
+  for (int i = firstRow; i < firstRow + rows; i++)
+  {
+    for (int j = firstCol; j < firstCol + cols; j++)
+    {
+      std::unordered_map<int, Space*>::iterator found =
+        spaces.find(i * boardCols + j);
+      out << (found != spaces.end() ? found->second->getSymbol() :
+                                      (*map)[i * boardCols + j]) << " ";
+    }
+    out << "\n";
+  }
+}
+
+// --- playerMove ---
+// Moves the player as on a normal board, then creates the spaces next to the
+// player's new space
+bool SharedBoard::playerMove(Space::Direction direction)
+{
+  if (!Board::playerMove(direction))
+  {
+    return false;
+  }
+
+  if (direction == Space::UP || direction == Space::DOWN)
+  {
+    playerRow += direction == Space::UP ? -1 : 1;
+  }
+  else
+  {
+    playerCol += direction == Space::LEFT ? -1 : 1;
+  }
+  surround(playerRow, playerCol);
+  return true;
+}
+
+// --- placePlayer ---
+// Moves the player straight to space, which must have come from this board
+void SharedBoard::placePlayer(Space* space)
+{
+  int row;
+  int col;
+  locate(space, row, col);
+  Board::placePlayer(space);
+  playerRow = row;
+  playerCol = col;
+}
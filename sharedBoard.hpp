@@ -0,0 +1,47 @@
+/*********************************************************************
+** Program name: sharedBoard.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: A board that shares its map, read only, with every other board
+** made from the same map. Spaces are created from the map only when the player
+** comes next to them or they are asked for, so a board holds just the part of
+** the map its player has reached, including every space the player changed.
+*********************************************************************/
+
+#ifndef SHAREDBOARD_HPP
+#define SHAREDBOARD_HPP
+
+#include "board.hpp"
+#include "space.hpp"
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+class SharedBoard : public Board
+{
+private:
+  std::unordered_map<int, Space*> spaces; // created spaces by cell
+  int playerRow; // player's position, kept so moves need not search spaces
+  int playerCol;
+
+  Space* reach(int row, int col);
+  void surround(int row, int col);
+
+public:
+  SharedBoard(const std::shared_ptr<const std::string>& map, int rows,
+              int cols);
+  virtual ~SharedBoard();
+
+  std::size_t getSpaceCount();
+
+  virtual Space* getSpace(int row, int col);
+  virtual void locate(Space* space, int& row, int& col);
+  virtual void placePlayer(Space* space);
+  virtual void print(std::ostream& out);
+
+  using Board::playerMove;
+  virtual bool playerMove(Space::Direction direction);
+};
+
+#endif
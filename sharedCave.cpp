@@ -0,0 +1,451 @@
+/*********************************************************************
+** Program name: sharedCave.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: One board played by many players at once, e.g. everyone
+** connected to the game server. The board is split into square regions, each
+** with its own lock, so players in different parts of the cave move at the
+** same time; an action locks only the regions it touches. Players cannot
+** share a space, and a hole filled or an item taken by one player is gone
+** for everyone until the last player leaves and the cave starts over.
+*********************************************************************/
+
+#include "sharedCave.hpp"
+#include "board.hpp"
+#include "event.hpp"
+#include "gameState.hpp"
+#include "player.hpp"
+#include "space.hpp"
+#include "symbols.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  const int VIEW_ROWS = 15; // rows and columns printed around the player
+  const int VIEW_COLS = 31;
+  const char OTHER_PLAYER = 'O';
+}
+
+// --- Caver::getPlayer ---
+Player* SharedCave::Caver::getPlayer()
+{
+  return &player;
+}
+
+// --- Caver::getSteps ---
+int SharedCave::Caver::getSteps()
+{
+  return steps;
+}
+
+// --- Caver::getOffer ---
+// Returns the offer waiting for ACCEPT or DECLINE, if any
+Space::Offer SharedCave::Caver::getOffer()
+{
+  return offer;
+}
+
+// --- Constructor ---
+// Creates the board for map, which has rows x cols symbols row by row, with
+// no one on it, and lists the empty spaces reachable from the start in order
+// of distance
+SharedCave::SharedCave(const std::string& map, int rows, int cols)
+  : board(map, rows, cols)
+{
+  this->rows = rows;
+  this->cols = cols;
+  board.getPlayerSpace()->setPlayer(false); // players are placed by join
+
+  cells.reserve(static_cast<std::size_t>(rows) * cols);
+  for (int i = 0; i < rows; i++)
+  {
+    Space* current = board.getSpace(i, 0);
+    for (int j = 0; j < cols; j++)
+    {
+      cells.push_back(current);
+      current = current->getAdjacent(Space::RIGHT);
+    }
+  }
+
+  regionCols = (cols + REGION_SIZE - 1) / REGION_SIZE;
+  int regionRows = (rows + REGION_SIZE - 1) / REGION_SIZE;
+  locks.reset(new std::mutex[regionRows * regionCols]);
+  changed.resize(regionRows * regionCols);
+
+  // Breadth-first search from the start at [1,1]
+  std::vector<bool> seen(cells.size(), false);
+  std::deque<int> queue;
+  queue.push_back(1 * cols + 1);
+  seen[1 * cols + 1] = true;
+  while (!queue.empty())
+  {
+    int cell = queue.front();
+    queue.pop_front();
+    if (cells[cell]->getDefaultSymbol() == EMPTY)
+    {
+      spawns.push_back(cell);
+    }
+
+    const int neighbours[] = { cell - cols, cell + cols, cell - 1, cell + 1 };
+    for (int i = 0; i < 4; i++)
+    {
+      int next = neighbours[i];
+      bool sameRow = i < 2 || next / cols == cell / cols;
+      if (next >= 0 && next < static_cast<int>(cells.size()) && sameRow &&
+          !seen[next] && cells[next]->isWalkable())
+      {
+        seen[next] = true;
+        queue.push_back(next);
+      }
+    }
+  }
+  nextSpawn = 0;
+  players = 0;
+}
+
+// --- regionOf ---
+// Returns the number of the region holding [row, col]
+int SharedCave::regionOf(int row, int col)
+{
+  return (row / REGION_SIZE) * regionCols + col / REGION_SIZE;
+}
+
+// --- lockRegions ---
+// Locks regions first and second, which may be the same; regions are always
+// locked in increasing order so that two actions never wait for each other
+void SharedCave::lockRegions(int first, int second)
+{
+  locks[std::min(first, second)].lock();
+  if (first != second)
+  {
+    locks[std::max(first, second)].lock();
+  }
+}
+
+// --- unlockRegions ---
+void SharedCave::unlockRegions(int first, int second)
+{
+  if (first != second)
+  {
+    locks[std::max(first, second)].unlock();
+  }
+  locks[std::min(first, second)].unlock();
+}
+
+// --- join ---
+// Adds a player on the next free empty space reachable from the start;
+// returns nullptr if every such space is taken
+SharedCave::Caver* SharedCave::join()
+{
+  std::lock_guard<std::mutex> guard(joinLock);
+
+  for (std::size_t tried = 0; tried < spawns.size(); tried++)
+  {
+    int cell = spawns[nextSpawn];
+    nextSpawn = (nextSpawn + 1) % spawns.size();
+
+    int row = cell / cols;
+    int col = cell % cols;
+    int region = regionOf(row, col);
+    Space* space = cells[cell];
+    locks[region].lock();
+    bool free = !space->hasPlayer() && space->getDefaultSymbol() == EMPTY;
+    if (free)
+    {
+      space->setPlayer(true);
+    }
+    locks[region].unlock();
+
+    if (free)
+    {
+      Caver* caver = new Caver;
+      caver->player.setState(Player::PLAYING);
+      caver->row = row;
+      caver->col = col;
+      caver->steps = GameState::START_STEPS;
+      caver->offer = Space::NO_OFFER;
+      caver->outcome.valid = true;
+      caver->outcome.moved = false;
+      caver->outcome.offer = Space::NO_OFFER;
+      players++;
+      return caver;
+    }
+  }
+  return nullptr;
+}
+
+// --- leave ---
+// Takes caver off the board, if it is still there, and deletes it; the cave
+// starts over once everyone has left
+void SharedCave::leave(Caver* caver)
+{
+  leaveBoard(caver);
+  delete caver;
+
+  std::lock_guard<std::mutex> guard(joinLock);
+  players--;
+  if (players == 0)
+  {
+    restart();
+  }
+}
+
+// --- restart ---
+// Puts back every space the players changed; called with no one in the cave
+// and joinLock held, so no other thread can be using the board
+void SharedCave::restart()
+{
+  std::string map = board.getMap();
+  for (int i = 0, n = changed.size(); i < n; i++)
+  {
+    for (int j = 0, m = changed[i].size(); j < m; j++)
+    {
+      cells[changed[i][j]]->restore(map[changed[i][j]]);
+    }
+    changed[i].clear();
+  }
+  nextSpawn = 0;
+}
+
+// --- leaveBoard ---
+// Frees caver's space for the other players once its game is over
+void SharedCave::leaveBoard(Caver* caver)
+{
+  if (caver->row < 0)
+  {
+    return;
+  }
+
+  int region = regionOf(caver->row, caver->col);
+  locks[region].lock();
+  cells[caver->row * cols + caver->col]->setPlayer(false);
+  locks[region].unlock();
+  caver->row = -1;
+  caver->col = -1;
+}
+
+// --- addEvent ---
+void SharedCave::addEvent(Caver* caver, Event::Type type)
+{
+  Event event = { type, 0 };
+  caver->outcome.events.push_back(event);
+}
+
+// --- step ---
+// Carries out action for caver by the same rules as GameState::step. A move
+// onto a space another player is on is blocked without using a step, so an
+// item goes to whoever reaches its space first. Undo and redo are not
+// available, as the cave is not caver's alone.
+const GameState::Outcome& SharedCave::step(Caver* caver,
+                                           GameState::Action action)
+{
+  GameState::Outcome& outcome = caver->outcome;
+  Player* player = &caver->player;
+  outcome.valid = true;
+  outcome.moved = false;
+  outcome.events.clear();
+
+  if (player->getState() != Player::PLAYING)
+  {
+    outcome.valid = false;
+    outcome.offer = caver->offer;
+    return outcome;
+  }
+
+  int region = regionOf(caver->row, caver->col);
+  Space* space = cells[caver->row * cols + caver->col];
+
+  if (caver->offer != Space::NO_OFFER) // player must answer the offer first
+  {
+    if (action == GameState::ACCEPT)
+    {
+      locks[region].lock();
+      char symbol = space->getDefaultSymbol();
+      space->accept(player, outcome.events);
+      if (space->getDefaultSymbol() != symbol)
+      {
+        changed[region].push_back(caver->row * cols + caver->col);
+      }
+      locks[region].unlock();
+      caver->offer = Space::NO_OFFER;
+    }
+    else if (action == GameState::DECLINE)
+    {
+      caver->offer = Space::NO_OFFER;
+    }
+    else
+    {
+      outcome.valid = false;
+    }
+    outcome.offer = caver->offer;
+    return outcome;
+  }
+
+  switch (action)
+  {
+    case GameState::MOVE_UP:
+    case GameState::MOVE_DOWN:
+    case GameState::MOVE_LEFT:
+    case GameState::MOVE_RIGHT:
+    {
+      Space::Direction direction = Space::UP;
+      int row = caver->row - 1;
+      int col = caver->col;
+      if (action == GameState::MOVE_DOWN)
+      {
+        direction = Space::DOWN;
+        row = caver->row + 1;
+      }
+      else if (action == GameState::MOVE_LEFT)
+      {
+        direction = Space::LEFT;
+        row = caver->row;
+        col = caver->col - 1;
+      }
+      else if (action == GameState::MOVE_RIGHT)
+      {
+        direction = Space::RIGHT;
+        row = caver->row;
+        col = caver->col + 1;
+      }
+
+      Space* target = space->getAdjacent(direction);
+      if (target == nullptr || !target->isWalkable())
+      {
+        break; // walls never change, so need no lock
+      }
+
+      int targetRegion = regionOf(row, col);
+      lockRegions(region, targetRegion);
+      if (target->hasPlayer())
+      {
+        addEvent(caver, Event::BLOCKED);
+      }
+      else
+      {
+        char symbol = target->getDefaultSymbol();
+        space->setPlayer(false);
+        target->setPlayer(true);
+        target->arrive(player, outcome.events);
+        if (target->getDefaultSymbol() != symbol)
+        {
+          changed[targetRegion].push_back(row * cols + col);
+        }
+        caver->row = row;
+        caver->col = col;
+        caver->steps--; // only successful moves use up a step
+        outcome.moved = true;
+      }
+      unlockRegions(region, targetRegion);
+      break;
+    }
+    case GameState::INSPECT:
+      locks[region].lock();
+      caver->offer = space->inspect(player, outcome.events);
+      locks[region].unlock();
+      break;
+    case GameState::INVENTORY:
+      addEvent(caver, Event::INVENTORY);
+      break;
+    case GameState::QUIT:
+      player->setState(Player::LOSE);
+      addEvent(caver, Event::QUIT);
+      break;
+    case GameState::ACCEPT:
+    case GameState::DECLINE:
+    case GameState::UNDO:
+    case GameState::REDO:
+      outcome.valid = false;
+      break;
+  }
+
+  // Game over if run out of steps, even if the last step reached the exit
+  if (caver->steps < 0)
+  {
+    player->setState(Player::LOSE);
+    addEvent(caver, Event::OUT_OF_STEPS);
+  }
+
+  if (player->getState() != Player::PLAYING)
+  {
+    caver->offer = Space::NO_OFFER;
+    leaveBoard(caver);
+  }
+
+  outcome.offer = caver->offer;
+  return outcome;
+}
+
+// --- print ---
+// Prints the part of the board around caver, or all of it if it is small,
+// showing caver as X and the other players as O
+void SharedCave::print(Caver* caver, std::ostream& out)
+{
+  int viewRows = std::min(rows, VIEW_ROWS);
+  int viewCols = std::min(cols, VIEW_COLS);
+  int centerRow = caver->row < 0 ? 1 : caver->row;
+  int centerCol = caver->col < 0 ? 1 : caver->col;
+  int firstRow = std::max(0, std::min(centerRow - viewRows / 2,
+                                      rows - viewRows));
+  int firstCol = std::max(0, std::min(centerCol - viewCols / 2,
+                                      cols - viewCols));
+  int lastRow = firstRow + viewRows - 1;
+  int lastCol = firstCol + viewCols - 1;
+
+  // Lock every region in view, in increasing order
+  for (int i = firstRow / REGION_SIZE; i <= lastRow / REGION_SIZE; i++)
+  {
+    for (int j = firstCol / REGION_SIZE; j <= lastCol / REGION_SIZE; j++)
+    {
+      locks[i * regionCols + j].lock();
+    }
+  }
+
+  out << "\n";
+  for (int i = firstRow; i <= lastRow; i++)
+  {
+    for (int j = firstCol; j <= lastCol; j++)
+    {
+      Space* space = cells[i * cols + j];
+      if (i == caver->row && j == caver->col)
+      {
+        out << space->getSymbol() << " ";
+      }
+      else if (space->hasPlayer())
+      {
+        out << OTHER_PLAYER << " ";
+      }
+      else
+      {
+        out << space->getSymbol() << " ";
+      }
+    }
+    out << "\n";
+  }
+
+  for (int i = lastRow / REGION_SIZE; i >= firstRow / REGION_SIZE; i--)
+  {
+    for (int j = lastCol / REGION_SIZE; j >= firstCol / REGION_SIZE; j--)
+    {
+      locks[i * regionCols + j].unlock();
+    }
+  }
+}
+
+// --- getRows ---
+int SharedCave::getRows()
+{
+  return rows;
+}
+
+// --- getCols ---
+int SharedCave::getCols()
+{
+  return cols;
+}
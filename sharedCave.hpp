@@ -0,0 +1,91 @@
+/*********************************************************************
+** Program name: sharedCave.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: One board played by many players at once, e.g. everyone
+** connected to the game server. The board is split into square regions, each
+** with its own lock, so players in different parts of the cave move at the
+** same time; an action locks only the regions it touches. Players cannot
+** share a space, and a hole filled or an item taken by one player is gone
+** for everyone until the last player leaves and the cave starts over.
+*********************************************************************/
+
+#ifndef SHAREDCAVE_HPP
+#define SHAREDCAVE_HPP
+
+#include "board.hpp"
+#include "gameState.hpp"
+#include "player.hpp"
+#include "space.hpp"
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class SharedCave
+{
+public:
+  static const int REGION_SIZE = 16; // rows and columns of spaces per lock
+
+  // A player in the cave, made by join. Only one thread at a time may act
+  // for a caver.
+  class Caver
+  {
+    friend class SharedCave;
+
+  private:
+    Player player;
+    int row; // position on the board; -1 once the game is over
+    int col;
+    int steps; // steps remaining
+    Space::Offer offer;
+    GameState::Outcome outcome; // reused by every step
+
+  public:
+    Player* getPlayer();
+    int getSteps();
+    Space::Offer getOffer();
+  };
+
+private:
+  Board board;
+  int rows;
+  int cols;
+  std::vector<Space*> cells; // every space, row by row
+  int regionCols; // regions across the board
+  std::unique_ptr<std::mutex[]> locks; // one per region
+  std::vector<std::vector<int> > changed; // cells changed in each region
+
+  // Spaces players join on, nearest to the start first; each join takes the
+  // next free one after the last one taken
+  std::vector<int> spawns;
+  std::size_t nextSpawn;
+  int players; // cavers not yet left
+  std::mutex joinLock; // guards the above
+
+  SharedCave(const SharedCave&) = delete;
+  SharedCave& operator=(const SharedCave&) = delete;
+
+  int regionOf(int row, int col);
+  void lockRegions(int first, int second);
+  void unlockRegions(int first, int second);
+  void leaveBoard(Caver* caver);
+  void addEvent(Caver* caver, Event::Type type);
+  void restart();
+
+public:
+  SharedCave(const std::string& map, int rows, int cols);
+
+  Caver* join(); // returns nullptr if there is no free space to join on
+  void leave(Caver* caver);
+
+  const GameState::Outcome& step(Caver* caver, GameState::Action action);
+  void print(Caver* caver, std::ostream& out);
+
+  int getRows();
+  int getCols();
+};
+
+#endif
@@ -0,0 +1,323 @@
+/*********************************************************************
+** Program name: simulate.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Plays a map many times with a computer player and reports the
+** win rate, steps used, causes of death, how often each space is visited and
+** playouts per second. Used to balance maps before shipping them and to catch
+** slowdowns in the rules.
+**
+** Games are split evenly over the worker threads. Each worker builds its own
+** board from the shared, read-only map and keeps its own statistics, which
+** are added together once every worker has finished, so no locks are taken
+** while games are running. Each worker's random seed comes from the seed and
+** the worker's number, so results depend only on the seed and thread count.
+**
+** With -batch, each worker instead steps that many games at once through a
+** GameBatch, taking uniformly random actions, and only the win rate and
+** throughput are reported; this measures how fast games can be fed to a
+** training loop. Batched games can be played under other rules with -rules.
+**
+** Usage: simulate [-map file] [-n playouts] [-policy random|careful]
+**                 [-seed n] [-threads n] [-batch games]
+**                 [-rules standard|hardcore|practice]
+*********************************************************************/
+
+#include "simulator.hpp"
+#include "gameBatch.hpp"
+#include "board.hpp"
+#include "gameState.hpp"
+#include "symbols.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  // Prints one line per step count that occurred, with a bar for its share
+  void printHistogram(const char* title, const std::vector<long>& counts,
+                      long total)
+  {
+    std::cout << "\n" << title << "\n";
+    for (int i = 0, n = counts.size(); i < n; i++)
+    {
+      if (counts[i] == 0)
+      {
+        continue;
+      }
+      double share = total > 0 ? 100.0 * counts[i] / total : 0;
+      std::cout << std::setw(5) << i << " steps " << std::setw(12) << counts[i]
+                << std::setw(8) << std::fixed << std::setprecision(2) << share
+                << "% " << std::string(static_cast<int>(share / 2), '#')
+                << "\n";
+    }
+  }
+
+  // Prints the map with each walkable space shown as a digit from 0 (rarely
+  // visited) to 9 (visited most), or . if never visited
+  void printVisits(const std::string& map, int rows, int cols,
+                   const std::vector<long>& visits)
+  {
+    long most = *std::max_element(visits.begin(), visits.end());
+
+    std::cout << "\nSpaces visited:\n";
+    for (int i = 0; i < rows; i++)
+    {
+      for (int j = 0; j < cols; j++)
+      {
+        int cell = i * cols + j;
+        if (map[cell] == WALL)
+        {
+          std::cout << WALL;
+        }
+        else if (visits[cell] == 0 || most == 0)
+        {
+          std::cout << '.';
+        }
+        else
+        {
+          std::cout << static_cast<char>('0' + visits[cell] * 9 / most);
+        }
+        std::cout << " ";
+      }
+      std::cout << "\n";
+    }
+  }
+
+  // Returns the random seed for worker number worker
+  unsigned long long workerSeed(unsigned long long seed, int worker)
+  {
+    unsigned long long mixed = seed + 0x9E3779B97F4A7C15ULL * (worker + 1);
+    mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+    return mixed ^ (mixed >> 31);
+  }
+
+  // Plays at least playouts games in batches of batchSize on each of threads
+  // workers with random actions under rules, and prints the win rate and
+  // throughput
+  template <typename Rules>
+  int runBatched(const std::string& mapFilename, const std::string& map,
+                 int rows, int cols, long playouts, int batchSize,
+                 unsigned long long seed, int threads, const Rules& rules)
+  {
+    std::vector<long> episodes(threads, 0);
+    std::vector<long> wins(threads, 0);
+    std::vector<long> steps(threads, 0);
+    std::vector<std::thread> workers;
+
+    GameBatch<Rules> check(map, rows, cols, 1, rules);
+    if (!check.isValid())
+    {
+      std::cout << "Map " << mapFilename << " cannot be played in a batch\n";
+      return 1;
+    }
+
+    std::chrono::steady_clock::time_point started =
+      std::chrono::steady_clock::now();
+
+    for (int t = 0; t < threads; t++)
+    {
+      long share = playouts / threads + (t < playouts % threads ? 1 : 0);
+      workers.push_back(std::thread([&, t, share]()
+      {
+        GameBatch<Rules> batch(map, rows, cols, batchSize, rules);
+        std::vector<std::uint8_t> actions(batchSize);
+        unsigned long long random = workerSeed(seed, t);
+        long stepCount = 0;
+
+        while (batch.getEpisodes() < share)
+        {
+          for (int i = 0; i < batchSize; i++)
+          {
+            random ^= random >> 12; // xorshift64*
+            random ^= random << 25;
+            random ^= random >> 27;
+            actions[i] = ((random * 0x2545F4914F6CDD1DULL) >> 32) %
+                         GameBatch<Rules>::ACTIONS;
+          }
+          batch.step(actions);
+          stepCount += batchSize;
+        }
+
+        episodes[t] = batch.getEpisodes(); // written once, by this worker only
+        wins[t] = batch.getWins();
+        steps[t] = stepCount;
+      }));
+    }
+
+    long totalEpisodes = 0;
+    long totalWins = 0;
+    long totalSteps = 0;
+    for (int t = 0; t < threads; t++)
+    {
+      workers[t].join();
+      totalEpisodes += episodes[t];
+      totalWins += wins[t];
+      totalSteps += steps[t];
+    }
+
+    double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - started).count();
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Map " << mapFilename << " (" << rows << "x" << cols << "), "
+              << "random actions in batches of " << batchSize << ", seed "
+              << seed << ", " << threads << " threads, " << rules.name()
+              << " rules\n"
+              << "Playouts:      " << totalEpisodes << "\n"
+              << "Wins:          " << totalWins << " ("
+              << 100.0 * totalWins / totalEpisodes << "%)\n"
+              << "\n" << std::setprecision(3) << seconds << " s, "
+              << std::setprecision(0) << totalEpisodes / seconds
+              << " playouts/sec, " << totalSteps / seconds
+              << " game steps/sec\n";
+    return 0;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  std::string mapFilename = "map.txt";
+  long playouts = 1000000;
+  Simulator::Policy policy = Simulator::RANDOM;
+  unsigned long long seed = 1;
+  int batchSize = 0; // games per batch; 0 to play them one at a time
+  std::string rules = "standard"; // for batched games only
+  int threads = std::thread::hardware_concurrency();
+  if (threads < 1)
+  {
+    threads = 1;
+  }
+
+  for (int i = 1; i + 1 < argc; i += 2)
+  {
+    std::string flag = argv[i];
+    std::string value = argv[i + 1];
+
+    if (flag == "-map")
+    {
+      mapFilename = value;
+    }
+    else if (flag == "-n")
+    {
+      playouts = std::atol(value.c_str());
+    }
+    else if (flag == "-policy" && (value == "random" || value == "careful"))
+    {
+      policy = value == "random" ? Simulator::RANDOM : Simulator::CAREFUL;
+    }
+    else if (flag == "-seed")
+    {
+      seed = std::strtoull(value.c_str(), nullptr, 10);
+    }
+    else if (flag == "-threads")
+    {
+      threads = std::atoi(value.c_str());
+    }
+    else if (flag == "-batch")
+    {
+      batchSize = std::atoi(value.c_str());
+    }
+    else if (flag == "-rules" &&
+             (value == "standard" || value == "hardcore" ||
+              value == "practice"))
+    {
+      rules = value;
+    }
+    else
+    {
+      playouts = 0;
+    }
+  }
+
+  if (argc % 2 == 0 || playouts <= 0 || threads <= 0 || batchSize < 0 ||
+      (rules != "standard" && batchSize == 0))
+  {
+    std::cout << "Usage: simulate [-map file] [-n playouts] "
+              << "[-policy random|careful] [-seed n] [-threads n] "
+              << "[-batch games] [-rules standard|hardcore|practice]\n";
+    return 1;
+  }
+
+  std::string map;
+  int rows;
+  int cols;
+  if (!Board::loadMap(mapFilename, map, rows, cols))
+  {
+    std::cout << "Could not read " << mapFilename << "\n";
+    return 1;
+  }
+
+  if (batchSize > 0 && rules == "hardcore")
+  {
+    return runBatched(mapFilename, map, rows, cols, playouts, batchSize, seed,
+                      threads, HardcoreRules());
+  }
+  else if (batchSize > 0 && rules == "practice")
+  {
+    return runBatched(mapFilename, map, rows, cols, playouts, batchSize, seed,
+                      threads, PracticeRules());
+  }
+  else if (batchSize > 0)
+  {
+    return runBatched(mapFilename, map, rows, cols, playouts, batchSize, seed,
+                      threads, StandardRules());
+  }
+
+  std::vector<Simulator::Stats> results(threads, Simulator::Stats(rows * cols));
+  std::vector<std::thread> workers;
+
+  std::chrono::steady_clock::time_point started =
+    std::chrono::steady_clock::now();
+
+  for (int t = 0; t < threads; t++)
+  {
+    long share = playouts / threads + (t < playouts % threads ? 1 : 0);
+    workers.push_back(std::thread([&, t, share]()
+    {
+      Simulator simulator(map, rows, cols, policy, workerSeed(seed, t));
+      Simulator::Stats local(simulator.getSpaces());
+      simulator.run(share, local);
+      results[t] = local; // written once, by this worker only
+    }));
+  }
+
+  Simulator::Stats stats(rows * cols);
+  for (int t = 0; t < threads; t++)
+  {
+    workers[t].join();
+    stats.merge(results[t]);
+  }
+
+  double seconds = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - started).count();
+
+  long losses = stats.fellInHole + stats.outOfSteps;
+  std::cout << std::fixed << std::setprecision(2)
+            << "Map " << mapFilename << " (" << rows << "x" << cols << "), "
+            << (policy == Simulator::RANDOM ? "random" : "careful")
+            << " player, seed " << seed << ", " << threads << " threads\n"
+            << "Playouts:      " << stats.playouts << "\n"
+            << "Wins:          " << stats.wins << " ("
+            << 100.0 * stats.wins / stats.playouts << "%)\n"
+            << "Fell in hole:  " << stats.fellInHole << "\n"
+            << "Out of steps:  " << stats.outOfSteps << "\n"
+            << "Stalled:       " << stats.stalled << "\n";
+
+  printHistogram("Steps used in wins:", stats.winSteps, stats.wins);
+  printHistogram("Steps used in losses:", stats.lossSteps, losses);
+  printVisits(map, rows, cols, stats.visits);
+
+  std::cout << "\n" << std::setprecision(3) << seconds << " s, "
+            << std::setprecision(0) << stats.playouts / seconds
+            << " playouts/sec\n";
+
+  return 0;
+}
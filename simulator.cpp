@@ -0,0 +1,228 @@
+/*********************************************************************
+** Program name: simulator.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Plays many games of one map with a computer player, using a
+** single game state that is reset between games so that no memory is
+** allocated once the first game is over. Collects win rates, steps used and
+** causes of death for balancing maps.
+*********************************************************************/
+
+#include "simulator.hpp"
+#include "board.hpp"
+#include "gameState.hpp"
+#include "player.hpp"
+#include "space.hpp"
+#include "symbols.hpp"
+#include <string>
+#include <vector>
+
+namespace
+{
+  const GameState::Action MOVES[] = { GameState::MOVE_UP, GameState::MOVE_DOWN,
+                                      GameState::MOVE_LEFT,
+                                      GameState::MOVE_RIGHT };
+  const Space::Direction DIRECTIONS[] = { Space::UP, Space::DOWN, Space::LEFT,
+                                          Space::RIGHT };
+}
+
+// --- Stats constructor ---
+// Step histograms have room for every step count up to running out; visits
+// has room for every space on the board
+Simulator::Stats::Stats(int spaces)
+  : winSteps(GameState::START_STEPS + 2, 0),
+    lossSteps(GameState::START_STEPS + 2, 0),
+    visits(spaces, 0)
+{
+  playouts = 0;
+  wins = 0;
+  fellInHole = 0;
+  outOfSteps = 0;
+  stalled = 0;
+}
+
+// --- Stats::merge ---
+// Adds the counts in other to these
+void Simulator::Stats::merge(const Stats& other)
+{
+  playouts += other.playouts;
+  wins += other.wins;
+  fellInHole += other.fellInHole;
+  outOfSteps += other.outOfSteps;
+  stalled += other.stalled;
+
+  for (int i = 0, n = winSteps.size(); i < n; i++)
+  {
+    winSteps[i] += other.winSteps[i];
+    lossSteps[i] += other.lossSteps[i];
+  }
+
+  for (int i = 0, n = visits.size(); i < n; i++)
+  {
+    visits[i] += other.visits[i];
+  }
+}
+
+// --- Constructor ---
+// Builds the one board used for every game; seed 0 is replaced because
+// xorshift cannot leave the all-zero state
+Simulator::Simulator(const std::string& map, int rows, int cols, Policy policy,
+                     unsigned long long seed)
+  : state(new Board(map, rows, cols), false)
+{
+  this->rows = rows;
+  this->cols = cols;
+  this->policy = policy;
+  random = seed != 0 ? seed : 0x9E3779B97F4A7C15ULL;
+}
+
+// --- nextRandom ---
+// xorshift64*; fast and good enough for choosing moves
+unsigned long long Simulator::nextRandom()
+{
+  random ^= random >> 12;
+  random ^= random << 25;
+  random ^= random >> 27;
+  return random * 0x2545F4914F6CDD1DULL;
+}
+
+// --- isSafe ---
+// Returns true if moving in direction would move the player without
+// dropping them into a hole they cannot fill
+bool Simulator::isSafe(Space::Direction direction)
+{
+  Space* target = state.getBoard()->getPlayerSpace()->getAdjacent(direction);
+  if (target == nullptr || !target->isWalkable())
+  {
+    return false;
+  }
+  return target->getDefaultSymbol() != HOLE ||
+         state.getPlayer()->hasItem(ROCK);
+}
+
+// --- chooseAction ---
+// Picks the computer player's next action according to policy
+GameState::Action Simulator::chooseAction()
+{
+  unsigned long long roll = nextRandom() >> 32;
+
+  if (state.getOffer() != Space::NO_OFFER)
+  {
+    if (policy == CAREFUL || roll % 2 == 0)
+    {
+      return GameState::ACCEPT;
+    }
+    return GameState::DECLINE;
+  }
+
+  if (policy == RANDOM)
+  {
+    return roll % 5 == 4 ? GameState::INSPECT : MOVES[roll % 4];
+  }
+
+  // Careful: inspect spaces with items, otherwise pick among safe moves
+  char symbol = state.getBoard()->getPlayerSpace()->getDefaultSymbol();
+  if ((symbol == ROCK || symbol == PICK) && roll % 2 == 0)
+  {
+    return GameState::INSPECT;
+  }
+
+  int safe[4];
+  int safeCount = 0;
+  for (int i = 0; i < 4; i++)
+  {
+    if (isSafe(DIRECTIONS[i]))
+    {
+      safe[safeCount++] = i;
+    }
+  }
+
+  if (safeCount == 0)
+  {
+    return MOVES[roll % 4]; // trapped; any move will do
+  }
+  return MOVES[safe[(roll >> 8) % safeCount]];
+}
+
+// --- getSpaces ---
+// Return the number of spaces on the board, i.e. the size of Stats::visits
+int Simulator::getSpaces()
+{
+  return rows * cols;
+}
+
+// --- run ---
+// Plays the given number of games, adding their results to stats, which must
+// have been created with getSpaces() spaces
+void Simulator::run(long playouts, Stats& stats)
+{
+  Player* player = state.getPlayer();
+
+  for (long game = 0; game < playouts; game++)
+  {
+    state.reset();
+
+    bool fell = false;
+    int actions = 0;
+    int cell = cols + 1; // player starts at [1,1]
+    while (player->getState() == Player::PLAYING && actions < MAX_ACTIONS)
+    {
+      GameState::Action action = chooseAction();
+      const GameState::Outcome& outcome = state.step(action);
+
+      if (outcome.moved)
+      {
+        switch (action)
+        {
+          case GameState::MOVE_UP:
+            cell -= cols;
+            break;
+          case GameState::MOVE_DOWN:
+            cell += cols;
+            break;
+          case GameState::MOVE_LEFT:
+            cell--;
+            break;
+          default:
+            cell++;
+            break;
+        }
+        stats.visits[cell]++;
+      }
+
+      for (int i = 0, n = outcome.events.size(); i < n; i++)
+      {
+        if (outcome.events[i].type == Event::FELL_IN_HOLE)
+        {
+          fell = true;
+        }
+      }
+      actions++;
+    }
+
+    int stepsUsed = GameState::START_STEPS - state.getSteps();
+    stats.playouts++;
+
+    if (player->getState() == Player::WIN)
+    {
+      stats.wins++;
+      stats.winSteps[stepsUsed]++;
+    }
+    else if (player->getState() == Player::PLAYING)
+    {
+      stats.stalled++;
+    }
+    else
+    {
+      if (fell)
+      {
+        stats.fellInHole++;
+      }
+      else
+      {
+        stats.outOfSteps++;
+      }
+      stats.lossSteps[stepsUsed]++;
+    }
+  }
+}
@@ -0,0 +1,63 @@
+/*********************************************************************
+** Program name: simulator.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Plays many games of one map with a computer player, using a
+** single game state that is reset between games so that no memory is
+** allocated once the first game is over. Collects win rates, steps used and
+** causes of death for balancing maps.
+*********************************************************************/
+
+#ifndef SIMULATOR_HPP
+#define SIMULATOR_HPP
+
+#include "gameState.hpp"
+#include <string>
+#include <vector>
+
+class Simulator
+{
+public:
+  enum Policy
+  {
+    RANDOM, // any action, offers accepted half the time
+    CAREFUL // never walks into walls or unfillable holes; accepts offers
+  };
+
+  static const int MAX_ACTIONS = 1000; // a game this long is counted as stalled
+
+  struct Stats
+  {
+    long playouts;
+    long wins;
+    long fellInHole;
+    long outOfSteps;
+    long stalled;
+    std::vector<long> winSteps; // number of wins using each number of steps
+    std::vector<long> lossSteps; // likewise for losses
+    std::vector<long> visits; // times each space was moved onto, row by row
+
+    Stats(int spaces);
+    void merge(const Stats& other);
+  };
+
+private:
+  GameState state;
+  int rows;
+  int cols;
+  Policy policy;
+  unsigned long long random; // xorshift state
+
+  unsigned long long nextRandom();
+  GameState::Action chooseAction();
+  bool isSafe(Space::Direction direction);
+
+public:
+  Simulator(const std::string& map, int rows, int cols, Policy policy,
+            unsigned long long seed);
+
+  int getSpaces();
+  void run(long playouts, Stats& stats);
+};
+
+#endif
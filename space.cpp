@@ -11,6 +11,7 @@
 // --- Constructor ---
 Space::Space()
 {
+  player = false;
 }
 
 // --- Destructor ---
@@ -53,6 +54,22 @@ char Space::getSymbol()
   return symbol;
 }
 
+// --- getDefaultSymbol ---
+// Return the symbol for the space's contents, ignoring the player
+char Space::getDefaultSymbol()
+{
+  return defaultSymbol;
+}
+
+// --- restore ---
+// Puts back a symbol the space had before arrive or accept changed it, e.g. to
+// reset the board for a new game
+void Space::restore(char symbol)
+{
+  defaultSymbol = symbol;
+  setPlayer(player);
+}
+
 void Space::setAdjacent(Space::Direction direction, Space* target)
 {
   switch (direction)
@@ -10,6 +10,7 @@
 #define SPACE_HPP
 
 #include "player.hpp"
+#include "event.hpp"
 
 class Space
 {
@@ -32,17 +33,22 @@ public:
   virtual ~Space();
 
   enum Direction {UP, DOWN, LEFT, RIGHT};
+  enum Offer {NO_OFFER, MINE_ROCKS, TAKE_PICK}; // choice offered on inspecting
 
   bool hasPlayer();
   void setPlayer(bool status);
   bool isWalkable();
   char getSymbol();
+  char getDefaultSymbol(); // symbol shown when the player is not on the space
+  void restore(char symbol); // undo a change made by arrive or accept
 
   void setAdjacent(Direction direction, Space* target);
   Space* getAdjacent(Direction direction);
 
-  virtual void arrive(Player* player) = 0;
-  virtual void inspect(Player* player) = 0;
+  // Rules for the space; what happens is added to events
+  virtual void arrive(Player* player, EventList& events) = 0;
+  virtual Offer inspect(Player* player, EventList& events) = 0;
+  virtual void accept(Player* player, EventList& events) {} // take the offer
   virtual void setSymbol(char symbol) {}
 };
 
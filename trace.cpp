@@ -0,0 +1,253 @@
+/*********************************************************************
+** Program name: trace.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Records when the slow parts of the game ran, on which thread,
+** as a Chrome trace_event JSON file that Perfetto or chrome://tracing shows as
+** a timeline. A Scope placed in a function records the time from its creation
+** to the end of the function. Each thread keeps its events in a ring buffer of
+** its own that it writes without locking, and a background thread empties
+** the rings into the file. Until start is called, a Scope only checks a flag.
+*********************************************************************/
+
+#include "trace.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  const char THREAD_NAME = 'M'; // phase of an event naming its thread
+  const char COMPLETE = 'X'; // phase of an event with a start and duration
+  const int FLUSH_MILLISECONDS = 100; // between emptying the rings
+
+  struct Event
+  {
+    const char* name;
+    const char* category;
+    char phase;
+    long long start; // nanoseconds since tracing started
+    long long duration;
+  };
+
+  // One thread's events. Only the thread writing it moves head, and only the
+  // flushing thread moves tail, so neither ever waits for the other.
+  struct Ring
+  {
+    Event events[Trace::RING_EVENTS];
+    std::atomic<unsigned long> head; // events written
+    std::atomic<unsigned long> tail; // events flushed
+    std::atomic<long> dropped; // events lost because the ring was full
+    int thread; // number shown as the thread ID
+
+    Ring(int thread) : head(0), tail(0), dropped(0)
+    {
+      this->thread = thread;
+    }
+  };
+
+  // Gives each thread a ring the first time it records an event, and hands
+  // the ring back when the thread ends so a later thread can use it
+  struct Writer
+  {
+    Ring* ring;
+
+    Writer() : ring(nullptr) {}
+    ~Writer();
+  };
+
+  std::atomic<bool> enabled(false);
+  std::chrono::steady_clock::time_point origin; // set before enabled
+
+  std::mutex lock; // guards everything below
+  std::vector<std::unique_ptr<Ring> > rings; // every ring ever used
+  std::vector<Ring*> freeRings; // rings whose threads have ended
+  std::FILE* file = nullptr;
+  bool firstEvent = true;
+  bool stopping = false;
+  std::condition_variable wake; // wakes the flushing thread to stop
+  std::thread flusher;
+
+  thread_local Writer writer;
+
+  Writer::~Writer()
+  {
+    if (ring != nullptr)
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      freeRings.push_back(ring);
+    }
+  }
+
+  long long sinceOrigin()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - origin).count();
+  }
+
+  // Adds event to this thread's ring, or counts it as dropped if the ring is
+  // full because the flushing thread has fallen behind
+  void add(const Event& event)
+  {
+    if (writer.ring == nullptr)
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      if (!freeRings.empty())
+      {
+        writer.ring = freeRings.back();
+        freeRings.pop_back();
+      }
+      else
+      {
+        rings.push_back(std::unique_ptr<Ring>(new Ring(rings.size() + 1)));
+        writer.ring = rings.back().get();
+      }
+    }
+
+    Ring& ring = *writer.ring;
+    unsigned long head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.tail.load(std::memory_order_acquire) >=
+        static_cast<unsigned long>(Trace::RING_EVENTS))
+    {
+      ring.dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    ring.events[head % Trace::RING_EVENTS] = event;
+    ring.head.store(head + 1, std::memory_order_release);
+  }
+
+  // Writes the events waiting in every ring to the file; lock must be held
+  void drain()
+  {
+    for (std::size_t i = 0; i < rings.size(); i++)
+    {
+      Ring& ring = *rings[i];
+      unsigned long tail = ring.tail.load(std::memory_order_relaxed);
+      unsigned long head = ring.head.load(std::memory_order_acquire);
+      for (; tail != head; tail++)
+      {
+        const Event& event = ring.events[tail % Trace::RING_EVENTS];
+        std::fputs(firstEvent ? "\n" : ",\n", file);
+        firstEvent = false;
+        if (event.phase == THREAD_NAME)
+        {
+          std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\","
+                       "\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                       ring.thread, event.name);
+        }
+        else
+        {
+          std::fprintf(file, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\","
+                       "\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                       event.name, event.category, ring.thread,
+                       event.start / 1000.0, event.duration / 1000.0);
+        }
+      }
+      ring.tail.store(tail, std::memory_order_release);
+    }
+  }
+
+  // Background thread; empties the rings every FLUSH_MILLISECONDS until
+  // tracing stops
+  void flush()
+  {
+    std::unique_lock<std::mutex> guard(lock);
+    while (!stopping)
+    {
+      wake.wait_for(guard,
+                    std::chrono::milliseconds(FLUSH_MILLISECONDS));
+      drain();
+      std::fflush(file);
+    }
+  }
+}
+
+// --- Scope constructor ---
+Trace::Scope::Scope(const char* name, const char* category)
+{
+  this->name = name;
+  this->category = category;
+  start = enabled.load(std::memory_order_relaxed) ? sinceOrigin() : -1;
+}
+
+// --- Scope destructor ---
+Trace::Scope::~Scope()
+{
+  if (start >= 0 && enabled.load(std::memory_order_relaxed))
+  {
+    Event event = { name, category, COMPLETE, start, sinceOrigin() - start };
+    add(event);
+  }
+}
+
+// --- start ---
+// Starts writing a trace to filename; returns false if it could not be
+// opened or a trace was already started
+bool Trace::start(const std::string& filename)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  if (file != nullptr)
+  {
+    return false;
+  }
+  file = std::fopen(filename.c_str(), "w");
+  if (file == nullptr)
+  {
+    return false;
+  }
+
+  std::fputs("{\"traceEvents\":[", file);
+  origin = std::chrono::steady_clock::now();
+  stopping = false;
+  flusher = std::thread(flush);
+  enabled = true;
+  return true;
+}
+
+// --- stop ---
+// Stops tracing, writes the events not yet flushed and closes the file; the
+// number of events dropped from full rings is written with them
+void Trace::stop()
+{
+  if (!enabled.exchange(false))
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    stopping = true;
+  }
+  wake.notify_one();
+  flusher.join();
+
+  std::lock_guard<std::mutex> guard(lock);
+  drain();
+  long dropped = 0;
+  for (std::size_t i = 0; i < rings.size(); i++)
+  {
+    dropped += rings[i]->dropped.load();
+  }
+  std::fprintf(file, "\n],\"displayTimeUnit\":\"ms\","
+               "\"otherData\":{\"dropped\":\"%ld\"}}\n", dropped);
+  std::fclose(file);
+  file = nullptr;
+}
+
+// --- nameThread ---
+// Names the calling thread in the trace, e.g. "main" or "solver"; name must
+// be a string literal
+void Trace::nameThread(const char* name)
+{
+  if (enabled.load(std::memory_order_relaxed))
+  {
+    Event event = { name, "", THREAD_NAME, 0, 0 };
+    add(event);
+  }
+}
@@ -0,0 +1,45 @@
+/*********************************************************************
+** Program name: trace.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Records when the slow parts of the game ran, on which thread,
+** as a Chrome trace_event JSON file that Perfetto or chrome://tracing shows as
+** a timeline. A Scope placed in a function records the time from its creation
+** to the end of the function. Each thread keeps its events in a ring buffer of
+** its own that it writes without locking, and a background thread empties
+** the rings into the file. Until start is called, a Scope only checks a flag.
+*********************************************************************/
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <string>
+
+class Trace
+{
+public:
+  static const int RING_EVENTS = 4096; // per thread; later events are dropped
+
+  // Records an event named name in category, both of which must be string
+  // literals, for as long as the scope lasts
+  class Scope
+  {
+  private:
+    const char* name;
+    const char* category;
+    long long start; // in nanoseconds, or -1 if tracing was off
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  public:
+    Scope(const char* name, const char* category);
+    ~Scope();
+  };
+
+  static bool start(const std::string& filename);
+  static void stop();
+  static void nameThread(const char* name);
+};
+
+#endif
@@ -0,0 +1,308 @@
+/*********************************************************************
+** Program name: turnStats.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Measures the console game's turns when it is started with
+** -stats: a latency histogram each for waiting on input, carrying out the
+** rules and drawing the board, and counts of moves, blocked moves,
+** inspections, spaces created and bytes written to the terminal. Games
+** without -stats have no TurnStats and take no measurements at all.
+*********************************************************************/
+
+#include "turnStats.hpp"
+#include "gameState.hpp"
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <streambuf>
+#include <vector>
+
+namespace
+{
+  const char* TIMER_NAMES[] = { "input wait", "rules", "render" };
+  const double PERCENTILES[] = { 50, 90, 99, 99.9 };
+  const int PERCENTILE_COUNT = sizeof(PERCENTILES) / sizeof(PERCENTILES[0]);
+}
+
+// --- Histogram constructor ---
+TurnStats::Histogram::Histogram()
+  : counts(SUB_BUCKETS * (MAX_BITS - SUB_BITS + 1), 0)
+{
+  total = 0;
+  sum = 0;
+  max = 0;
+}
+
+// --- bucketOf ---
+// Returns the bucket counting value: values below 2 * SUB_BUCKETS have a
+// bucket each, and above that each doubling of the value is split into
+// SUB_BUCKETS buckets
+int TurnStats::Histogram::bucketOf(long long value)
+{
+  int shift = 0;
+  while ((value >> shift) >= 2 * SUB_BUCKETS)
+  {
+    shift++;
+  }
+  return SUB_BUCKETS * shift + static_cast<int>(value >> shift);
+}
+
+// --- valueOf ---
+// Returns the value in the middle of bucket
+long long TurnStats::Histogram::valueOf(int bucket)
+{
+  int shift = bucket < 2 * SUB_BUCKETS ? 0 : bucket / SUB_BUCKETS - 1;
+  long long lowest = static_cast<long long>(bucket - SUB_BUCKETS * shift)
+                     << shift;
+  return lowest + ((1LL << shift) - 1) / 2;
+}
+
+// --- record ---
+void TurnStats::Histogram::record(long long nanoseconds)
+{
+  if (nanoseconds < 0)
+  {
+    nanoseconds = 0;
+  }
+  if (nanoseconds >= 1LL << MAX_BITS)
+  {
+    nanoseconds = (1LL << MAX_BITS) - 1;
+  }
+  counts[bucketOf(nanoseconds)]++;
+  total++;
+  sum += nanoseconds;
+  if (nanoseconds > max)
+  {
+    max = nanoseconds;
+  }
+}
+
+// --- getCount ---
+long long TurnStats::Histogram::getCount()
+{
+  return total;
+}
+
+// --- getMean ---
+double TurnStats::Histogram::getMean()
+{
+  return total > 0 ? static_cast<double>(sum) / total : 0;
+}
+
+// --- getMax ---
+long long TurnStats::Histogram::getMax()
+{
+  return max;
+}
+
+// --- getPercentile ---
+// Returns the latency that percent of those recorded were at or below
+long long TurnStats::Histogram::getPercentile(double percent)
+{
+  long long wanted = static_cast<long long>(percent / 100 * total + 0.5);
+  if (wanted < 1)
+  {
+    wanted = 1;
+  }
+
+  long long seen = 0;
+  for (int i = 0, n = counts.size(); i < n; i++)
+  {
+    seen += counts[i];
+    if (seen >= wanted)
+    {
+      long long value = valueOf(i);
+      return value < max ? value : max;
+    }
+  }
+  return max;
+}
+
+// --- CountingBuffer constructor ---
+TurnStats::CountingBuffer::CountingBuffer(std::streambuf* target)
+{
+  this->target = target;
+  bytes = 0;
+  setp(buffer, buffer + sizeof(buffer));
+}
+
+// --- CountingBuffer destructor ---
+TurnStats::CountingBuffer::~CountingBuffer()
+{
+  pass();
+}
+
+// --- pass ---
+// Passes the gathered bytes on to the target; returns false if it did not
+// take them all
+bool TurnStats::CountingBuffer::pass()
+{
+  std::streamsize waiting = pptr() - pbase();
+  std::streamsize passed = waiting > 0 ? target->sputn(pbase(), waiting) : 0;
+  bytes += passed;
+  setp(buffer, buffer + sizeof(buffer));
+  return passed == waiting;
+}
+
+// --- overflow ---
+// Called when the buffer is full: passes it on and keeps c, if any
+TurnStats::CountingBuffer::int_type TurnStats::CountingBuffer::overflow(
+  int_type c)
+{
+  if (!pass())
+  {
+    return traits_type::eof();
+  }
+  if (!traits_type::eq_int_type(c, traits_type::eof()))
+  {
+    return sputc(traits_type::to_char_type(c));
+  }
+  return traits_type::not_eof(c);
+}
+
+// --- sync ---
+// Called on flush, e.g. before reading input from a stream tied to this one
+int TurnStats::CountingBuffer::sync()
+{
+  return pass() && target->pubsync() == 0 ? 0 : -1;
+}
+
+// --- getBytes ---
+// Returns the bytes passed on so far
+long long TurnStats::CountingBuffer::getBytes()
+{
+  return bytes;
+}
+
+// --- Constructor ---
+TurnStats::TurnStats()
+{
+  moves = 0;
+  blocked = 0;
+  inspects = 0;
+  spaces = 0;
+  turns = 0;
+  games = 0;
+  counted = nullptr;
+  original = nullptr;
+  counter = nullptr;
+}
+
+// --- Destructor ---
+// Stops counting the bytes written to the counted stream, if any
+TurnStats::~TurnStats()
+{
+  if (counted != nullptr)
+  {
+    counted->flush();
+    counted->rdbuf(original);
+    delete counter;
+  }
+}
+
+// --- countBytes ---
+// Counts the bytes written to out from now until the stats are deleted
+void TurnStats::countBytes(std::ostream& out)
+{
+  if (counted != nullptr)
+  {
+    return;
+  }
+  counted = &out;
+  original = out.rdbuf();
+  counter = new CountingBuffer(original);
+  out.rdbuf(counter);
+}
+
+// --- now ---
+// Returns the time in nanoseconds, for passing to mark
+long long TurnStats::now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// --- mark ---
+// Records the time since started under timer and returns the time now, which
+// can be passed to the next mark if the next measurement starts here
+long long TurnStats::mark(Timer timer, long long started)
+{
+  long long time = now();
+  timers[timer].record(time - started);
+  return time;
+}
+
+// --- countAction ---
+// Counts an action the player took and its outcome
+void TurnStats::countAction(GameState::Action action,
+                            const GameState::Outcome& outcome)
+{
+  turns++;
+  if (action == GameState::MOVE_UP || action == GameState::MOVE_DOWN ||
+      action == GameState::MOVE_LEFT || action == GameState::MOVE_RIGHT)
+  {
+    if (outcome.moved)
+    {
+      moves++;
+    }
+    else
+    {
+      blocked++;
+    }
+  }
+  else if (action == GameState::INSPECT)
+  {
+    inspects++;
+  }
+}
+
+// --- countGame ---
+// Counts a finished game whose board created spacesCreated spaces
+void TurnStats::countGame(long long spacesCreated)
+{
+  games++;
+  spaces += spacesCreated;
+}
+
+// --- print ---
+// Prints the latencies, in microseconds, and the counts so far
+void TurnStats::print(std::ostream& out)
+{
+  if (counted != nullptr)
+  {
+    counted->flush(); // so every byte written so far is counted
+  }
+
+  out << games << " games, " << turns << " actions\n\n"
+      << std::left << std::setw(12) << "us" << std::right << std::setw(10)
+      << "count" << std::setw(12) << "mean";
+  for (int i = 0; i < PERCENTILE_COUNT; i++)
+  {
+    std::ostringstream label;
+    label << "p" << PERCENTILES[i];
+    out << std::setw(12) << label.str();
+  }
+  out << std::setw(12) << "max" << "\n";
+
+  out << std::fixed << std::setprecision(1);
+  for (int i = 0; i < TIMER_COUNT; i++)
+  {
+    Histogram& timer = timers[i];
+    out << std::left << std::setw(12) << TIMER_NAMES[i] << std::right
+        << std::setw(10) << timer.getCount() << std::setw(12)
+        << timer.getMean() / 1000;
+    for (int j = 0; j < PERCENTILE_COUNT; j++)
+    {
+      out << std::setw(12) << timer.getPercentile(PERCENTILES[j]) / 1000.0;
+    }
+    out << std::setw(12) << timer.getMax() / 1000.0 << "\n";
+  }
+
+  out << "\nmoves           " << moves
+      << "\nblocked moves   " << blocked
+      << "\ninspections     " << inspects
+      << "\nspaces created  " << spaces
+      << "\nbytes written   "
+      << (counter != nullptr ? counter->getBytes() : 0) << "\n";
+}
@@ -0,0 +1,111 @@
+/*********************************************************************
+** Program name: turnStats.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Measures the console game's turns when it is started with
+** -stats: a latency histogram each for waiting on input, carrying out the
+** rules and drawing the board, and counts of moves, blocked moves,
+** inspections, spaces created and bytes written to the terminal. Games
+** without -stats have no TurnStats and take no measurements at all.
+*********************************************************************/
+
+#ifndef TURNSTATS_HPP
+#define TURNSTATS_HPP
+
+#include "gameState.hpp"
+#include <iosfwd>
+#include <streambuf>
+#include <vector>
+
+class TurnStats
+{
+public:
+  // What a latency is measured for
+  enum Timer
+  {
+    INPUT, // from the board being drawn until an action is chosen
+    RULES, // GameState::step: the move and what the space does on arrival
+    RENDER, // drawing the board
+    TIMER_COUNT
+  };
+
+  // Latencies in nanoseconds, counted in buckets whose width is 1/SUB_BUCKETS
+  // of the values in them, so each is known to within about 3% from 1 ns to
+  // days, in a fixed, small amount of memory
+  class Histogram
+  {
+  public:
+    static const int SUB_BITS = 5;
+    static const int SUB_BUCKETS = 1 << SUB_BITS;
+    static const int MAX_BITS = 48; // values from 2^48 ns (3 days) are clamped
+
+  private:
+    std::vector<long long> counts; // by bucket
+    long long total;
+    long long sum;
+    long long max;
+
+    static int bucketOf(long long value);
+    static long long valueOf(int bucket);
+
+  public:
+    Histogram();
+
+    void record(long long nanoseconds);
+    long long getCount();
+    double getMean();
+    long long getMax();
+    long long getPercentile(double percent);
+  };
+
+private:
+  // Passes everything written to a stream on to its own buffer, counting
+  // the bytes; the writes are gathered in a buffer of its own, so counting
+  // costs one addition per buffer full rather than one per byte
+  class CountingBuffer : public std::streambuf
+  {
+  private:
+    std::streambuf* target;
+    char buffer[1024];
+    long long bytes;
+
+    bool pass();
+
+  protected:
+    virtual int_type overflow(int_type c);
+    virtual int sync();
+
+  public:
+    CountingBuffer(std::streambuf* target);
+    ~CountingBuffer();
+
+    long long getBytes();
+  };
+
+  Histogram timers[TIMER_COUNT];
+  long long moves;
+  long long blocked; // moves into a wall or off the board
+  long long inspects;
+  long long spaces; // created for finished games' boards
+  long long turns; // actions taken
+  int games;
+  std::ostream* counted; // stream whose bytes are counted, if any
+  std::streambuf* original; // its buffer before counting began
+  CountingBuffer* counter;
+
+  TurnStats(const TurnStats&) = delete;
+  TurnStats& operator=(const TurnStats&) = delete;
+
+public:
+  TurnStats();
+  ~TurnStats();
+
+  void countBytes(std::ostream& out);
+  static long long now();
+  long long mark(Timer timer, long long started);
+  void countAction(GameState::Action action, const GameState::Outcome& outcome);
+  void countGame(long long spacesCreated);
+  void print(std::ostream& out);
+};
+
+#endif
@@ -0,0 +1,187 @@
+/*********************************************************************
+** Program name: verify.cpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Checks replays submitted as proof of wins on a map: the
+** replays named on the command line, which must be wins, and with -log the
+** replay of every player's best win in a leaderboard log, which must be a win
+** in the steps the leaderboard shows. Reports how many replays passed, why
+** the others failed and how many replays were checked per second; -repeat
+** checks the list that many times over, to benchmark the verifier.
+**
+** Usage: verify [-map file] [-log file] [-threads n] [-repeat n]
+**               [replay ...]
+*********************************************************************/
+
+#include "replayVerifier.hpp"
+#include "board.hpp"
+#include "leaderboard.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  const int MAX_LISTED = 20; // failed replays listed by name
+}
+
+int main(int argc, char* argv[])
+{
+  std::string mapFilename = "map.txt";
+  std::string logFilename;
+  int threads = std::thread::hardware_concurrency();
+  if (threads < 1)
+  {
+    threads = 1;
+  }
+  int repeat = 1;
+
+  std::vector<ReplayVerifier::Submission> submissions;
+  std::vector<std::string> names; // of the player who submitted each replay
+  bool valid = true;
+  for (int i = 1; valid && i < argc; i++)
+  {
+    std::string flag = argv[i];
+    if (flag.empty() || flag[0] != '-')
+    {
+      ReplayVerifier::Submission submission = { flag, -1 };
+      submissions.push_back(submission);
+      names.push_back("");
+      continue;
+    }
+
+    valid = i + 1 < argc;
+    if (!valid)
+    {
+      break;
+    }
+    std::string value = argv[++i];
+    if (flag == "-map")
+    {
+      mapFilename = value;
+    }
+    else if (flag == "-log")
+    {
+      logFilename = value;
+    }
+    else if (flag == "-threads")
+    {
+      threads = std::atoi(value.c_str());
+    }
+    else if (flag == "-repeat")
+    {
+      repeat = std::atoi(value.c_str());
+    }
+    else
+    {
+      valid = false;
+    }
+  }
+
+  if (!valid || threads < 1 || repeat < 1 ||
+      (submissions.empty() && logFilename.empty()))
+  {
+    std::cout << "Usage: verify [-map file] [-log file] [-threads n] "
+              << "[-repeat n] [replay ...]\n";
+    return 1;
+  }
+
+  std::string map;
+  int rows;
+  int cols;
+  if (!Board::loadMap(mapFilename, map, rows, cols))
+  {
+    std::cout << "Could not read " << mapFilename << "\n";
+    return 1;
+  }
+
+  long unrecorded = 0;
+  if (!logFilename.empty())
+  {
+    Leaderboard leaderboard;
+    if (!leaderboard.open(logFilename))
+    {
+      std::cout << "Could not read " << logFilename << "\n";
+      return 1;
+    }
+    unsigned long long mapHash = Board::hashMap(map);
+    std::vector<Leaderboard::Entry> entries =
+      leaderboard.getTop(mapHash, leaderboard.getPlayers(mapHash));
+    for (int i = 0, n = entries.size(); i < n; i++)
+    {
+      if (entries[i].replay.empty())
+      {
+        unrecorded++;
+        continue;
+      }
+      ReplayVerifier::Submission submission = { entries[i].replay,
+                                                entries[i].steps };
+      submissions.push_back(submission);
+      names.push_back(entries[i].name);
+    }
+  }
+
+  // Repeat the list for benchmarking
+  std::vector<ReplayVerifier::Submission> all;
+  for (int r = 0; r < repeat; r++)
+  {
+    all.insert(all.end(), submissions.begin(), submissions.end());
+  }
+
+  ReplayVerifier verifier(map, rows, cols);
+  std::vector<ReplayVerifier::Verdict> verdicts;
+  std::chrono::steady_clock::time_point started =
+    std::chrono::steady_clock::now();
+  verifier.verify(all, threads, verdicts);
+  double seconds = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - started).count();
+
+  long counts[ReplayVerifier::VERDICT_COUNT] = { 0 };
+  for (int i = 0, n = verdicts.size(); i < n; i++)
+  {
+    counts[verdicts[i]]++;
+  }
+
+  int listed = 0;
+  for (int i = 0, n = submissions.size(); i < n && listed < MAX_LISTED; i++)
+  {
+    if (verdicts[i] != ReplayVerifier::VERIFIED)
+    {
+      std::cout << submissions[i].filename;
+      if (!names[i].empty())
+      {
+        std::cout << " (" << names[i] << ", " << submissions[i].steps
+                  << " steps)";
+      }
+      std::cout << ": " << ReplayVerifier::getVerdictName(verdicts[i]) << "\n";
+      listed++;
+    }
+  }
+
+  std::cout << "Checked " << all.size() << " replays on " << threads
+            << " threads:";
+  for (int v = 0; v < ReplayVerifier::VERDICT_COUNT; v++)
+  {
+    if (counts[v] > 0)
+    {
+      std::cout << " " << counts[v] << " "
+                << ReplayVerifier::getVerdictName(
+                     static_cast<ReplayVerifier::Verdict>(v)) << ",";
+    }
+  }
+  std::cout << std::fixed << std::setprecision(0) << " "
+            << (seconds > 0 ? all.size() / seconds : 0) << " replays/sec, "
+            << (seconds > 0 ? verifier.getTurns() / seconds : 0)
+            << " turns/sec\n";
+  if (unrecorded > 0)
+  {
+    std::cout << unrecorded << " wins on the leaderboard have no replay\n";
+  }
+
+  return counts[ReplayVerifier::VERIFIED] == static_cast<long>(all.size()) ?
+         0 : 1;
+}
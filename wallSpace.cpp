@@ -8,6 +8,8 @@
 #include "wallSpace.hpp"
 #include "player.hpp"
 #include "symbols.hpp"
+#include "memoryStats.hpp"
+#include <cstddef>
 
 // --- Constructor ---
 WallSpace::WallSpace()
@@ -22,16 +24,29 @@ WallSpace::~WallSpace()
 {
 }
 
+// --- operator new ---
+void* WallSpace::operator new(std::size_t size)
+{
+  return MemoryStats::allocate(MemoryStats::WALL_SPACES, size);
+}
+
+// --- operator delete ---
+void WallSpace::operator delete(void* pointer, std::size_t size)
+{
+  MemoryStats::release(MemoryStats::WALL_SPACES, pointer, size);
+}
+
 // --- arrive ---
 // Executes upon player arriving in a space;
 // does nothing for a wall space because it is not walkable
-void WallSpace::arrive(Player* player)
+void WallSpace::arrive(Player* player, EventList& events)
 {
 }
 
 // --- inspect ---
 // Executes upon player choosing to inspect current space;
 // does nothing for a wall space because it is not walkable
-void WallSpace::inspect(Player* player)
+Space::Offer WallSpace::inspect(Player* player, EventList& events)
 {
+  return NO_OFFER;
 }
\ No newline at end of file
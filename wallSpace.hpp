@@ -10,6 +10,7 @@
 
 #include "space.hpp"
 #include "player.hpp"
+#include <cstddef>
 
 class WallSpace : public Space
 {
@@ -17,8 +18,13 @@ private:
 public:
   WallSpace();
   virtual ~WallSpace();
-  virtual void arrive(Player* player);
-  virtual void inspect(Player* player);
+
+  // Counted in MemoryStats
+  static void* operator new(std::size_t size);
+  static void operator delete(void* pointer, std::size_t size);
+
+  virtual void arrive(Player* player, EventList& events);
+  virtual Offer inspect(Player* player, EventList& events);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,104 @@
+/*********************************************************************
+** Program name: workQueue.hpp
+** Author: Jesse McKenna
+** Date: 10/19/2026
+** Description: Bounded, blocking queue used to pass work between the
+** concurrent stages of the level tools. Producers block while the queue is
+** full, consumers block while it is empty, and close() releases everyone once
+** the producing stage is finished.
+*********************************************************************/
+
+#ifndef WORKQUEUE_HPP
+#define WORKQUEUE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+template <typename T>
+class WorkQueue
+{
+private:
+  std::size_t capacity;
+  bool closed;
+  std::deque<T> items;
+
+  std::mutex lock;
+  std::condition_variable notFull;
+  std::condition_variable notEmpty;
+
+public:
+  WorkQueue(std::size_t capacity);
+
+  bool push(T item); // returns false if the queue was closed
+  bool pop(T& item); // returns false once closed and drained
+  void close();
+};
+
+// --- Constructor ---
+template <typename T>
+WorkQueue<T>::WorkQueue(std::size_t capacity)
+{
+  this->capacity = capacity > 0 ? capacity : 1;
+  closed = false;
+}
+
+// --- push ---
+// Waits for room in the queue, then adds item; returns false without adding
+// the item if the queue has been closed
+template <typename T>
+bool WorkQueue<T>::push(T item)
+{
+  std::unique_lock<std::mutex> guard(lock);
+  while (!closed && items.size() >= capacity)
+  {
+    notFull.wait(guard);
+  }
+
+  if (closed)
+  {
+    return false;
+  }
+
+  items.push_back(std::move(item));
+  notEmpty.notify_one();
+  return true;
+}
+
+// --- pop ---
+// Waits for an item and moves it into item; returns false once the queue has
+// been closed and every remaining item has been taken
+template <typename T>
+bool WorkQueue<T>::pop(T& item)
+{
+  std::unique_lock<std::mutex> guard(lock);
+  while (!closed && items.empty())
+  {
+    notEmpty.wait(guard);
+  }
+
+  if (items.empty())
+  {
+    return false;
+  }
+
+  item = std::move(items.front());
+  items.pop_front();
+  notFull.notify_one();
+  return true;
+}
+
+// --- close ---
+// Stops accepting new items and wakes every waiting producer and consumer
+template <typename T>
+void WorkQueue<T>::close()
+{
+  std::lock_guard<std::mutex> guard(lock);
+  closed = true;
+  notFull.notify_all();
+  notEmpty.notify_all();
+}
+
+#endif